@@ -0,0 +1,56 @@
+#include "../Other/TestPrefix.h"
+#include "../Other/Benchmark.h"
+
+#include <thread>
+
+namespace
+{
+    // A value type that is too large to be stored inline, so any allocates it from the MemoryPool
+    struct LargeRectangle
+    {
+        LargeRectangle(const Rectangle<int>& rectangle)
+        : rectangle(rectangle) {}
+
+        bool operator==(const LargeRectangle& other) const { return (rectangle == other.rectangle); }
+
+        Rectangle<int> rectangle;
+        char padding[128] = {};
+    };
+
+    // Wraps and copies numValues large values on each of numThreads threads at the same time
+    BenchmarkResult wrapLargeValues(const std::string& name, int numThreads, int numValues)
+    {
+        return measureBenchmark(name, numValues, [numThreads, numValues]() {
+            std::vector<std::thread> threads;
+
+            for (int i = 0; i < numThreads; i++) {
+                threads.emplace_back([numValues]() {
+                    for (int j = 0; j < numValues; j++) {
+                        detail::any large(LargeRectangle(Rectangle<int>(j, j, 10, 10)));
+                        detail::any copy(large);
+                    }
+                });
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+        });
+    }
+} // namespace
+
+TEST_CASE("any throughput",
+          "[.][benchmark][any]")
+{
+    IT("hardly uses the global allocator when wrapping large values on multiple threads")
+    {
+        MemoryPool::prewarm();
+        const int numValues = 200000;
+        const auto singleThreaded = wrapLargeValues("1 thread", 1, numValues);
+        const auto multiThreaded = wrapLargeValues("4 threads at the same time", 4, numValues);
+
+        reportBenchmark("Wrapping and copying a large value", { singleThreaded, multiThreaded });
+
+        // The threads share the prewarmed blocks, so only starting the threads and filling their caches allocates
+        REQUIRE(multiThreaded.allocationsPerItem < 0.01);
+    }
+}
@@ -0,0 +1,73 @@
+#include "../Other/TestPrefix.h"
+#include "../Other/AllocationCounter.h"
+#include "../Other/Benchmark.h"
+
+namespace
+{
+    const int NumStages = 8;
+
+    // Appends a typical GUI-binding stage (conversions, range checks) to an Observable
+    Observable<float> addStage(const Observable<float>& observable, int index)
+    {
+        if (index % 2 == 0)
+            return observable.map([](float value) { return value * 0.5f + 0.25f; });
+        else
+            return observable.filter([](float value) { return value < 1000.f; });
+    }
+
+    // Emits numValues values through a chain of NumStages map/filter stages.
+    // If interleaved is true, a skip(0) is inserted between adjacent stages, so they can't be fused. Otherwise, the same number of skip(0)s is appended after the stages.
+    // numSubscribeAllocations is set to the number of allocations for subscribing, which grows with the number of observers in the chain.
+    BenchmarkResult emitThroughStages(const std::string& name, int numValues, bool interleaved, size_t& numSubscribeAllocations)
+    {
+        PublishSubject<float> subject;
+        Observable<float> observable = subject;
+
+        for (int i = 0; i < NumStages; i++) {
+            observable = addStage(observable, i);
+
+            if (interleaved && i < NumStages - 1)
+                observable = observable.skip(0);
+        }
+
+        if (!interleaved) {
+            for (int i = 0; i < NumStages - 1; i++)
+                observable = observable.skip(0);
+        }
+
+        DisposeBag disposeBag;
+        int numReceived = 0;
+
+        {
+            const AllocationCounter counter;
+            observable.subscribe([&numReceived](float) { numReceived++; }).disposedBy(disposeBag);
+            numSubscribeAllocations = counter.getNumAllocations();
+        }
+
+        const auto result = measureBenchmark(name, numValues, [&subject, numValues]() {
+            for (int i = 0; i < numValues; i++)
+                subject.onNext(static_cast<float>(i % 100));
+        });
+
+        CHECK(numReceived == numValues);
+        return result;
+    }
+} // namespace
+
+TEST_CASE("Operator fusion",
+          "[.][benchmark][Observable]")
+{
+    IT("creates fewer observers for map and filter stages that are fused")
+    {
+        const int numValues = 20000;
+        size_t interleavedAllocations = 0;
+        size_t fusedAllocations = 0;
+        const auto interleaved = emitThroughStages("not fused", numValues, true, interleavedAllocations);
+        const auto fused = emitThroughStages("fused", numValues, false, fusedAllocations);
+
+        reportBenchmark("Emitting through " + std::to_string(NumStages) + " map and filter stages", { interleaved, fused });
+
+        // The fused stages run in a single observer, instead of one observer per stage
+        REQUIRE(fusedAllocations < interleavedAllocations);
+    }
+}
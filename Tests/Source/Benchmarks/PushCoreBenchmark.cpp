@@ -0,0 +1,49 @@
+#include "../Other/TestPrefix.h"
+#include "../Other/Benchmark.h"
+
+namespace
+{
+    // Emits numValues values through a typical model-binding chain.
+    // If throughRxCpp is true, the chain starts with a takeUntil(never), which is implemented with rxcpp. So all following operators run in rxcpp, like they did before the push core.
+    BenchmarkResult emitThroughChain(const std::string& name, int numValues, bool throughRxCpp)
+    {
+        PublishSubject<int> subject;
+        Observable<int> observable = subject;
+
+        if (throughRxCpp)
+            observable = observable.takeUntil(Observable<int>::never());
+
+        DisposeBag disposeBag;
+        int numReceived = 0;
+
+        observable.distinctUntilChanged()
+            .scan(0, [](int sum, int value) { return sum + value; })
+            .skip(1)
+            .map([](int sum) { return sum * 2; })
+            .subscribe([&numReceived](int) { numReceived++; })
+            .disposedBy(disposeBag);
+
+        const auto result = measureBenchmark(name, numValues, [&subject, numValues]() {
+            for (int i = 0; i < numValues; i++)
+                subject.onNext(i);
+        });
+
+        CHECK(numReceived == numValues - 1);
+        return result;
+    }
+} // namespace
+
+TEST_CASE("Push core",
+          "[.][benchmark][Observable]")
+{
+    IT("doesn't allocate per emission for synchronous operators")
+    {
+        const int numValues = 20000;
+        const auto rxcpp = emitThroughChain("rxcpp", numValues, true);
+        const auto native = emitThroughChain("push core", numValues, false);
+
+        reportBenchmark("Emitting through a subject and 4 operators", { rxcpp, native });
+
+        REQUIRE(native.allocationsPerItem == 0);
+    }
+}
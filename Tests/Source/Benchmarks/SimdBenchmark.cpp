@@ -0,0 +1,75 @@
+#include "../Other/TestPrefix.h"
+#include "../Other/Benchmark.h"
+
+namespace
+{
+    const int BatchSize = 512;
+
+    // Emits numValues samples through a gain and RMS stage.
+    // If batched is true, the samples are emitted in batches through the simd operators. Otherwise, they are emitted one at a time through map and scan.
+    // numCalls is set to the number of times the subscriber has been called while measuring.
+    BenchmarkResult emitSamples(const std::string& name, int numValues, bool batched, int& numCalls)
+    {
+        TypedPublishSubject<float> subject;
+        DisposeBag disposeBag;
+        float level = 0;
+
+        if (batched) {
+            simd::rms(simd::affine(subject, 0.5f), BatchSize)
+                .subscribe([&level, &numCalls](float rms) { level = rms; numCalls++; })
+                .disposedBy(disposeBag);
+        }
+        else {
+            subject.map([](float sample) { return sample * 0.5f; })
+                .scan(0.f, [](float sumOfSquares, float sample) { return sumOfSquares + sample * sample; })
+                .subscribe([&level, &numCalls](float sumOfSquares) { level = sumOfSquares; numCalls++; })
+                .disposedBy(disposeBag);
+        }
+
+        HeapBlock<float> samples(BatchSize);
+
+        for (int i = 0; i < BatchSize; i++)
+            samples[i] = std::sin(i * 0.1f);
+
+        const auto emitBatch = [&]() {
+            if (batched) {
+                subject.onNextBatch(samples, BatchSize);
+            }
+            else {
+                for (int j = 0; j < BatchSize; j++)
+                    subject.onNext(samples[j]);
+            }
+        };
+
+        // The first batch allocates the buffers that the operators reuse
+        emitBatch();
+        numCalls = 0;
+
+        const auto result = measureBenchmark(name, numValues, [&emitBatch, numValues]() {
+            for (int i = 0; i < numValues; i += BatchSize)
+                emitBatch();
+        });
+
+        CHECK(level > 0);
+        return result;
+    }
+} // namespace
+
+TEST_CASE("simd operators",
+          "[.][benchmark][TypedObservable][simd]")
+{
+    IT("emits one level per window, without allocating")
+    {
+        const int numValues = BatchSize * 400;
+        int scalarCalls = 0;
+        int batchedCalls = 0;
+        const auto scalar = emitSamples("map and scan", numValues, false, scalarCalls);
+        const auto batched = emitSamples("simd, in batches", numValues, true, batchedCalls);
+
+        reportBenchmark("Emitting samples through a gain and RMS stage", { scalar, batched });
+
+        // The simd chain calls the subscriber once per window, instead of once per sample
+        REQUIRE(batchedCalls == numValues / BatchSize);
+        REQUIRE(batched.allocationsPerItem == 0);
+    }
+}
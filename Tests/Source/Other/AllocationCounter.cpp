@@ -0,0 +1,39 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<size_t> numAllocations(0);
+}
+
+AllocationCounter::AllocationCounter()
+: start(getTotalNumAllocations())
+{}
+
+size_t AllocationCounter::getNumAllocations() const
+{
+    return getTotalNumAllocations() - start;
+}
+
+size_t AllocationCounter::getTotalNumAllocations()
+{
+    return numAllocations.load();
+}
+
+// Replaces the global operator new, to count allocations. The array forms call these by default.
+void* operator new(std::size_t size)
+{
+    numAllocations++;
+
+    if (void* ptr = std::malloc(size > 0 ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ Counts the number of heap allocations (calls to the global operator new) since it was created.
+ 
+ Used by the benchmarks, to compare the number of allocations per emitted value.
+ */
+class AllocationCounter
+{
+public:
+    AllocationCounter();
+
+    /// Returns the number of allocations since this instance was created, on any thread.
+    size_t getNumAllocations() const;
+
+    /// Returns the total number of allocations since the app was started.
+    static size_t getTotalNumAllocations();
+
+private:
+    const size_t start;
+};
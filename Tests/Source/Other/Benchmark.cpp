@@ -0,0 +1,27 @@
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+
+#include <chrono>
+#include <iostream>
+
+BenchmarkResult measureBenchmark(const std::string& name, int numItems, const std::function<void()>& run)
+{
+    const AllocationCounter counter;
+    const auto start = std::chrono::steady_clock::now();
+
+    run();
+
+    const auto end = std::chrono::steady_clock::now();
+    const size_t numAllocations = counter.getNumAllocations();
+    const double nanoseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+    return { name, nanoseconds / numItems, static_cast<double>(numAllocations) / numItems };
+}
+
+void reportBenchmark(const std::string& description, const std::vector<BenchmarkResult>& results)
+{
+    std::cout << description << ":" << std::endl;
+
+    for (const auto& result : results)
+        std::cout << "    " << result.name << ": " << result.nanosecondsPerItem << " ns, " << result.allocationsPerItem << " allocations per item" << std::endl;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ The average duration and number of heap allocations per item (e.g. per emitted value) of a benchmark run.
+ */
+struct BenchmarkResult
+{
+    /// Describes how the items were processed, like "rxcpp" or "push core".
+    std::string name;
+
+    double nanosecondsPerItem;
+    double allocationsPerItem;
+};
+
+/**
+ Calls `run` once, and measures its wall-clock duration and the number of heap allocations (on any thread) while it runs.
+ 
+ `run` should process `numItems` items. Set up everything that shouldn't be measured (like subscriptions) before.
+ */
+BenchmarkResult measureBenchmark(const std::string& name, int numItems, const std::function<void()>& run);
+
+/// Prints the results of runs that do the same work in different ways, so they can be compared.
+void reportBenchmark(const std::string& description, const std::vector<BenchmarkResult>& results);
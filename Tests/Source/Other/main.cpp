@@ -22,6 +22,12 @@ public:
         Catch::ConfigData config;
         //		config.shouldDebugBreak = true;
 
+        // Tags on the command line select the tests to run. The benchmarks are hidden, so they only run with "[benchmark]".
+        for (auto& argument : getCommandLineParameterArray()) {
+            if (argument.startsWith("["))
+                config.testsOrTags.push_back(argument.toStdString());
+        }
+
         Catch::Session session;
         session.useConfigData(config);
         session.run();
@@ -1,4 +1,5 @@
 #include "../Other/TestPrefix.h"
+#include "../Other/AllocationCounter.h"
 
 using Catch::Contains;
 using detail::any;
@@ -129,6 +130,18 @@ TEST_CASE("any",
             REQUIRE(anyPoint != any(Point<int64>(4, 15)));
         }
 
+        IT("distinguishes types with the same layout")
+        {
+            struct Meters { int value; bool operator==(const Meters& other) const { return value == other.value; } };
+            struct Seconds { int value; bool operator==(const Seconds& other) const { return value == other.value; } };
+            any meters(Meters { 3 });
+
+            REQUIRE(meters.is<Meters>());
+            REQUIRE_FALSE(meters.is<Seconds>());
+            REQUIRE(meters != any(Seconds { 3 }));
+            REQUIRE_THROWS_WITH(meters.get<Seconds>(), Contains("Error getting type from any."));
+        }
+
         IT("holds an independent copy of the original value")
         {
             // Create point, wrap it in any
@@ -143,6 +156,53 @@ TEST_CASE("any",
         }
     }
 
+    CONTEXT("small objects")
+    {
+        IT("stores an independent copy in each instance")
+        {
+            any original(Point<int>(3, 4));
+            any copy(original);
+
+            REQUIRE(copy == original);
+            REQUIRE(&copy.get<Point<int>>() != &original.get<Point<int>>());
+        }
+
+        IT("can be reassigned to a different type")
+        {
+            any value(Rectangle<int>(1, 2, 3, 4));
+            value = any(String("Hello"));
+            REQUIRE(value.get<String>() == "Hello");
+
+            value = any(17);
+            REQUIRE(value.get<int>() == 17);
+            REQUIRE_FALSE(value.is<String>());
+        }
+
+        IT("keeps the value when moving")
+        {
+            any original(Colours::red);
+            any moved(std::move(original));
+
+            REQUIRE(moved.get<Colour>() == Colours::red);
+        }
+
+        IT("doesn't allocate when wrapping and copying small values")
+        {
+            const AllocationCounter counter;
+
+            for (int i = 0; i < 100; i++) {
+                any rectangle(Rectangle<int>(i, i, 10, 10));
+                any point(Point<float>(1.f, 2.f));
+                any colour(Colours::red);
+                any empty((Empty()));
+                any copy(rectangle);
+                copy = point;
+            }
+
+            REQUIRE(counter.getNumAllocations() == 0);
+        }
+    }
+
     CONTEXT("pointers")
     {
         IT("can store a pointer to a struct")
@@ -354,5 +414,17 @@ TEST_CASE("any",
             REQUIRE(ptrRef.get() == address);
             REQUIRE(*ptrRef == 17);
         }
+        
+        IT("shares a move-only type with getShared, without copying it")
+        {
+            auto ptr = std::unique_ptr<int>(new int(17));
+            int* const address = ptr.get();
+            any anyPtr(std::move(ptr));
+            
+            auto shared = anyPtr.getShared<std::unique_ptr<int>>();
+            
+            REQUIRE(shared.get() == &anyPtr.get<std::unique_ptr<int>>());
+            REQUIRE(shared->get() == address);
+        }
     }
 }
@@ -48,6 +48,80 @@ TEST_CASE("LockFreeSource",
             // The newest value should be discarded
             REQUIRE(values.getLast() != 382);
         }
+
+        IT("emits at most maxItems values per callback with a DrainBudget")
+        {
+            DrainBudget budget;
+            budget.maxItems = 2;
+            source.setDrainBudget(budget);
+
+            for (auto i : { 1, 2, 3, 4, 5 })
+                source.onNext(i, CongestionPolicy::Allocate);
+
+            ReaX_RunDispatchLoopUntil(values.size() == 5);
+            ReaX_RequireValues(values, 1, 2, 3, 4, 5);
+
+            const DrainMetrics metrics = source.getDrainMetrics();
+            REQUIRE(metrics.numItems == 5);
+            REQUIRE(metrics.numCallbacks >= 3);
+            REQUIRE(metrics.numBudgetExhausted == 2);
+        }
+    }
+    
+    CONTEXT("TypedObservable")
+    {
+        Array<float> values;
+        LockFreeSource<float> source(4);
+        ReaX_CollectValues(source.asTypedObservable().map([](float f) { return f * 2; }), values);
+        
+        IT("emits values asynchronously via the TypedObservable")
+        {
+            for (auto f : {0.25f, 1.5f})
+                source.onNext(f, CongestionPolicy::DropOldest);
+            
+            CHECK(values.isEmpty());
+            
+            ReaX_RunDispatchLoopUntil(values.size() == 2);
+            ReaX_RequireValues(values, 0.5f, 3.f);
+        }
+
+        IT("emits the queued values as one batch")
+        {
+            Array<int> batchSizes;
+            source.asTypedObservable().subscribeBatches([&](const float*, size_t numValues) { batchSizes.add(static_cast<int>(numValues)); });
+
+            for (auto f : {0.25f, 1.5f, 3.f})
+                source.onNext(f, CongestionPolicy::DropOldest);
+
+            ReaX_RunDispatchLoopUntil(values.size() == 3);
+            ReaX_CheckValues(values, 0.5f, 3.f, 6.f);
+            ReaX_RequireValues(batchSizes, 3);
+        }
+    }
+    
+    CONTEXT("Move-only type")
+    {
+        Array<int> values;
+        LockFreeSource<std::unique_ptr<int>> source(4);
+        source.subscribe([&](const std::unique_ptr<int>& ptr) { values.add(*ptr); });
+        
+        IT("moves values through the queue and emits them")
+        {
+            for (auto i : {3, 5})
+                source.onNext(std::unique_ptr<int>(new int(i)), CongestionPolicy::Allocate);
+            
+            ReaX_RunDispatchLoopUntil(values.size() == 2);
+            ReaX_RequireValues(values, 3, 5);
+        }
+        
+        IT("can discard the oldest values")
+        {
+            for (int i = 0; i < 100; ++i)
+                source.onNext(std::unique_ptr<int>(new int(i)), CongestionPolicy::DropOldest);
+            
+            ReaX_RunDispatchLoopUntil(values.size() == 4);
+            ReaX_RequireValues(values, 96, 97, 98, 99);
+        }
     }
     
     CONTEXT("move semantics")
@@ -1,4 +1,7 @@
 #include "../Other/TestPrefix.h"
+#include "../Other/AllocationCounter.h"
+
+#include <thread>
 
 TEST_CASE("LockFreeTarget",
           "[LockFreeTarget][ReleasePool]")
@@ -21,6 +24,57 @@ TEST_CASE("LockFreeTarget",
         REQUIRE(value == -14.274f);
     }
     
+    IT("enqueues a batch of values at once")
+    {
+        LockFreeTarget<int> target;
+        const int values[] = { 3, 4, 5 };
+        target.onNextBatch(values, 3);
+
+        int value;
+        CHECK(target.tryDequeue(value));
+        CHECK(value == 3);
+        CHECK(target.tryDequeueAll(value));
+        REQUIRE(value == 5);
+    }
+
+    IT("enqueues a batch from a subscribed Observable without allocating")
+    {
+        PublishSubject<int> subject;
+        LockFreeTarget<int> target;
+        subject.subscribe(target);
+
+        // The first batch allocates the reused buffers and a block in the queue
+        const int values[] = { 3, 4, 5 };
+        subject.onNextBatch(values, 3);
+        int value;
+        CHECK(target.tryDequeueAll(value));
+        CHECK(value == 5);
+
+        const AllocationCounter counter;
+        const int moreValues[] = { 6, 7, 8 };
+        subject.onNextBatch(moreValues, 3);
+        CHECK(counter.getNumAllocations() == 0);
+
+        CHECK(target.tryDequeue(value));
+        CHECK(value == 6);
+        CHECK(target.tryDequeueAll(value));
+        REQUIRE(value == 8);
+    }
+
+    IT("enqueues a batch of values that is passed to it as an Observer")
+    {
+        LockFreeTarget<int> target;
+        const Observer<int>& observer = target;
+        const int values[] = { 3, 4, 5 };
+        observer.onNextBatch(values, 3);
+
+        int value;
+        CHECK(target.tryDequeue(value));
+        CHECK(value == 3);
+        CHECK(target.tryDequeueAll(value));
+        REQUIRE(value == 5);
+    }
+
     IT("retrieves String values")
     {
         PublishSubject<String> subject;
@@ -91,6 +145,66 @@ TEST_CASE("LockFreeTarget",
         REQUIRE(value == 312);
     }
     
+    IT("shares move-only values")
+    {
+        PublishSubject<std::unique_ptr<int>> subject;
+        LockFreeTarget<std::unique_ptr<int>> target;
+        subject.subscribe(target);
+        
+        std::unique_ptr<int> ptr(new int(17));
+        int* const address = ptr.get();
+        subject.onNext(std::move(ptr));
+        
+        std::shared_ptr<const std::unique_ptr<int>> value;
+        CHECK(target.tryDequeue(value));
+        REQUIRE(value->get() == address);
+    }
+    
+    IT("moves a move-only value out of the queue if it's the only owner")
+    {
+        PublishSubject<std::unique_ptr<int>> subject;
+        LockFreeTarget<std::unique_ptr<int>> target;
+        subject.subscribe(target);
+        
+        std::unique_ptr<int> ptr(new int(17));
+        int* const address = ptr.get();
+        subject.onNext(std::move(ptr));
+        
+        std::unique_ptr<int> value;
+        CHECK(target.tryTake(value));
+        CHECK(value.get() == address);
+        REQUIRE_FALSE(target.tryTake(value));
+    }
+    
+    IT("moves move-only values that are emitted on another thread out of the queue, without losing any")
+    {
+        PublishSubject<std::unique_ptr<int>> subject;
+        LockFreeTarget<std::unique_ptr<int>> target;
+        subject.subscribe(target);
+        
+        std::thread producer([&subject]() {
+            for (int i = 0; i < 10000; i++)
+                subject.onNext(std::unique_ptr<int>(new int(i)));
+        });
+        
+        Array<int> taken;
+        const auto startTime = Time::getMillisecondCounter();
+        
+        while (taken.size() < 10000 && Time::getMillisecondCounter() < startTime + 5 * 1000) {
+            std::unique_ptr<int> value;
+            
+            if (target.tryTake(value))
+                taken.add(*value);
+        }
+        
+        producer.join();
+        
+        REQUIRE(taken.size() == 10000);
+        
+        for (int i = 0; i < taken.size(); i++)
+            REQUIRE(taken[i] == i);
+    }
+    
     CONTEXT("queue is empty")
     {
         LockFreeTarget<int64> target;
@@ -0,0 +1,141 @@
+#include "../Other/TestPrefix.h"
+#include "../Other/AllocationCounter.h"
+
+#include <thread>
+
+using detail::any;
+
+namespace
+{
+    // Too large to be stored inline, so any allocates it from the pool
+    struct LargeValue
+    {
+        explicit LargeValue(int value)
+        : value(value) {}
+
+        bool operator==(const LargeValue& other) const { return (value == other.value); }
+
+        int value;
+        char padding[200] = {};
+    };
+
+    // Too large to be pooled
+    struct HugeValue
+    {
+        explicit HugeValue(int value)
+        : value(value) {}
+
+        int value;
+        char padding[2000] = {};
+    };
+} // namespace
+
+TEST_CASE("MemoryPool",
+          "[MemoryPool][any]")
+{
+    IT("keeps pooled values intact")
+    {
+        std::vector<any> values;
+
+        for (int i = 0; i < 1000; i++)
+            values.emplace_back(LargeValue(i));
+
+        for (size_t i = 0; i < values.size(); i++)
+            CHECK(values[i].get<LargeValue>().value == static_cast<int>(i));
+
+        values.clear();
+
+        // The blocks are reused, so boxing the values again doesn't allocate (the vector keeps its capacity)
+        const AllocationCounter counter;
+
+        for (int i = 0; i < 1000; i++)
+            values.emplace_back(LargeValue(i));
+
+        CHECK(counter.getNumAllocations() == 0);
+        REQUIRE(values[17].get<LargeValue>().value == 17);
+    }
+
+    IT("doesn't allocate memory for boxed values after prewarming")
+    {
+        MemoryPool::prewarm();
+        std::vector<any> values;
+        values.reserve(100);
+
+        // Creates the cache of this thread, if it doesn't exist yet
+        const any first((LargeValue(0)));
+
+        const AllocationCounter counter;
+
+        for (int i = 0; i < 100; i++)
+            values.emplace_back(LargeValue(i));
+
+        CHECK(counter.getNumAllocations() == 0);
+        REQUIRE(values.back().get<LargeValue>().value == 99);
+    }
+
+    IT("doesn't allocate memory when emitting large values after prewarming")
+    {
+        MemoryPool::prewarm();
+        PublishSubject<LargeValue> subject;
+        DisposeBag disposeBag;
+        int sum = 0;
+
+        subject.map([](const LargeValue& value) { return value; })
+            .filter([](const LargeValue&) { return true; })
+            .subscribe([&sum](const LargeValue& value) { sum += value.value; })
+            .disposedBy(disposeBag);
+
+        // Creates the cache of this thread, if it doesn't exist yet
+        subject.onNext(LargeValue(1));
+
+        const AllocationCounter counter;
+
+        for (int i = 0; i < 100; i++)
+            subject.onNext(LargeValue(1));
+
+        CHECK(counter.getNumAllocations() == 0);
+        REQUIRE(sum == 101);
+    }
+
+    IT("supports values that are too large to be pooled")
+    {
+        any huge((HugeValue(42)));
+        any copy(huge);
+
+        REQUIRE(copy.get<HugeValue>().value == 42);
+    }
+
+    IT("supports releasing values on another thread")
+    {
+        std::vector<any> values;
+
+        for (int i = 0; i < 1000; i++)
+            values.emplace_back(LargeValue(i));
+
+        std::thread([&values]() { values.clear(); }).join();
+
+        any value((LargeValue(3)));
+        REQUIRE(value.get<LargeValue>().value == 3);
+    }
+
+    IT("supports emitting values from multiple threads at the same time")
+    {
+        PublishSubject<LargeValue> subject;
+        std::atomic<int> sum(0);
+        subject.subscribe([&sum](const LargeValue& value) { sum += value.value; });
+
+        std::vector<std::thread> threads;
+
+        for (int i = 0; i < 4; i++) {
+            threads.emplace_back([subject]() {
+                for (int j = 0; j < 1000; j++)
+                    subject.onNext(LargeValue(1));
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        REQUIRE(sum.load() == 4000);
+    }
+}
@@ -0,0 +1,115 @@
+#include "../Other/TestPrefix.h"
+
+
+TEST_CASE("MergeHub",
+          "[MergeHub]")
+{
+    auto hub = std::make_shared<MergeHub<int>>();
+    Array<int> values;
+    ReaX_CollectValues(hub->asObservable(), values);
+
+    PublishSubject<int> first;
+    PublishSubject<int> second;
+
+    IT("emits the values from all sources that have been added")
+    {
+        hub->add(first);
+        hub->add(second);
+        CHECK(hub->getNumSources() == 2);
+
+        first.onNext(1);
+        second.onNext(2);
+        first.onNext(3);
+
+        ReaX_RequireValues(values, 1, 2, 3);
+    }
+
+    IT("stops emitting the values from a source after removing it")
+    {
+        const auto handle = hub->add(first);
+        hub->add(second);
+        first.onNext(1);
+
+        hub->remove(handle);
+        CHECK(hub->getNumSources() == 1);
+        first.onNext(2);
+        second.onNext(3);
+
+        ReaX_RequireValues(values, 1, 3);
+    }
+
+    IT("ignores a handle of a source that has already been removed")
+    {
+        const auto handle = hub->add(first);
+        hub->remove(handle);
+
+        // Probably reuses the same slot
+        hub->add(second);
+        hub->remove(handle);
+        second.onNext(1);
+
+        CHECK(hub->getNumSources() == 1);
+        ReaX_RequireValues(values, 1);
+    }
+
+    IT("removes a source when it completes, and doesn't complete")
+    {
+        bool completed = false;
+        hub->asObservable().subscribe([](int) {}, [](std::exception_ptr) {}, [&]() { completed = true; });
+
+        hub->add(Observable<int>::from({ 4, 5 }));
+        hub->add(first);
+        first.onCompleted();
+
+        CHECK(hub->getNumSources() == 0);
+        CHECK(!completed);
+        ReaX_RequireValues(values, 4, 5);
+    }
+
+    IT("supports many sources")
+    {
+        OwnedArray<PublishSubject<int>> subjects;
+        Array<MergeHub<int>::Handle> handles;
+
+        for (int i = 0; i < 500; i++)
+            handles.add(hub->add(*subjects.add(new PublishSubject<int>())));
+
+        for (int i = 0; i < 500; i += 2)
+            hub->remove(handles[i]);
+
+        for (auto subject : subjects)
+            subject->onNext(1);
+
+        CHECK(hub->getNumSources() == 250);
+        REQUIRE(values.size() == 250);
+    }
+
+    IT("forwards an error, and unsubscribes from all sources")
+    {
+        // Not the shared hub, because its values are collected without an onError handler
+        MergeHub<int> failingHub;
+        bool onErrorCalled = false;
+        failingHub.asObservable().subscribe([&values](int value) { values.add(value); }, [&](std::exception_ptr) { onErrorCalled = true; });
+
+        failingHub.add(first);
+        failingHub.add(Observable<int>::error(std::runtime_error("Error")));
+        first.onNext(1);
+
+        CHECK(onErrorCalled);
+        CHECK(failingHub.getNumSources() == 0);
+        REQUIRE(values.isEmpty());
+    }
+
+    IT("unsubscribes from all sources and completes when it's destroyed")
+    {
+        bool completed = false;
+        hub->asObservable().subscribe([](int) {}, [](std::exception_ptr) {}, [&]() { completed = true; });
+        hub->add(first);
+
+        hub.reset();
+        first.onNext(1);
+
+        CHECK(completed);
+        REQUIRE(values.isEmpty());
+    }
+}
@@ -19,6 +19,17 @@ TEST_CASE("Observable::create",
         ReaX_RequireValues(values, "First", "Second");
     }
 
+    IT("emits move-only values")
+    {
+        auto observable = Observable<std::unique_ptr<String>>::create([](Observer<std::unique_ptr<String>> observer) {
+            observer.onNext(std::unique_ptr<String>(new String("First")));
+            observer.onNext(std::unique_ptr<String>(new String("Second")));
+        });
+        observable.subscribe([&](const std::unique_ptr<String>& string) { values.add(*string); });
+
+        ReaX_RequireValues(values, "First", "Second");
+    }
+
     IT("emits values when pushing values asynchronously")
     {
         auto observable = Observable<String>::create([](Observer<String> observer) {
@@ -13,6 +13,139 @@ String concatStrings<String>(String s)
     return s;
 }
 
+TEST_CASE("Observable::bufferWithCount",
+          "[Observable][Observable::bufferWithCount]")
+{
+    Array<Array<int>> values;
+    PublishSubject<int> subject;
+
+    IT("emits batches of the given size")
+    {
+        ReaX_CollectValues(subject.bufferWithCount(2), values);
+
+        for (int i : { 1, 2, 3, 4, 5 })
+            subject.onNext(i);
+
+        ReaX_RequireValues(values, Array<int>({ 1, 2 }), Array<int>({ 3, 4 }));
+    }
+
+    IT("emits the remaining values on completion")
+    {
+        ReaX_CollectValues(Observable<int>::range(1, 5).bufferWithCount(2), values);
+
+        ReaX_RequireValues(values, Array<int>({ 1, 2 }), Array<int>({ 3, 4 }), Array<int>({ 5 }));
+    }
+
+    IT("reuses the storage of the emitted Array")
+    {
+        Array<const int*> storage;
+        subject.bufferWithCount(3).subscribe([&](const Array<int>& batch) { storage.add(batch.begin()); });
+
+        for (int i = 0; i < 9; i++)
+            subject.onNext(i);
+
+        REQUIRE(storage.size() == 3);
+        REQUIRE(storage[0] == storage[1]);
+        REQUIRE(storage[1] == storage[2]);
+    }
+
+    IT("keeps values that the observer emits while a batch is emitted")
+    {
+        subject.bufferWithCount(2).subscribe([&](const Array<int>& batch) {
+            values.add(batch);
+
+            if (batch.getFirst() == 1) {
+                subject.onNext(3);
+                subject.onNext(4);
+            }
+        });
+
+        subject.onNext(1);
+        subject.onNext(2);
+
+        ReaX_RequireValues(values, Array<int>({ 1, 2 }), Array<int>({ 3, 4 }));
+    }
+
+    IT("calls the observer without holding its lock")
+    {
+        // The observer waits for another thread that emits a value. If the batches were emitted while holding the lock, this would deadlock.
+        int numBatches = 0;
+        DisposeBag disposeBag;
+
+        subject.bufferWithCount(1).subscribe([&](const Array<int>&) {
+            if (++numBatches == 1)
+                std::thread([&subject]() { subject.onNext(2); }).join();
+        }).disposedBy(disposeBag);
+
+        subject.onNext(1);
+
+        REQUIRE(numBatches == 2);
+    }
+}
+
+
+TEST_CASE("Observable::bufferWithTime",
+          "[Observable][Observable::bufferWithTime]")
+{
+    Array<Array<int>> values;
+    PublishSubject<int> subject;
+
+    IT("emits the values from each interval as one batch, on the message thread")
+    {
+        ReaX_CollectValues(subject.bufferWithTime(RelativeTime::milliseconds(20)), values);
+
+        for (int i : { 1, 2, 3 })
+            subject.onNext(i);
+
+        CHECK(values.isEmpty());
+
+        ReaX_RunDispatchLoopUntil(values.size() == 1);
+        ReaX_CheckValues(values, Array<int>({ 1, 2, 3 }));
+
+        subject.onNext(4);
+
+        ReaX_RunDispatchLoopUntil(values.size() == 2);
+        ReaX_RequireValues(values, Array<int>({ 1, 2, 3 }), Array<int>({ 4 }));
+    }
+
+    IT("emits the batches on a given Scheduler")
+    {
+        const auto scheduler = Scheduler::virtualTime();
+        ReaX_CollectValues(subject.bufferWithTime(RelativeTime::milliseconds(20), scheduler), values);
+
+        for (int i : { 1, 2, 3 })
+            subject.onNext(i);
+
+        scheduler.advanceBy(RelativeTime::milliseconds(19));
+        CHECK(values.isEmpty());
+
+        scheduler.advanceBy(RelativeTime::milliseconds(1));
+        ReaX_CheckValues(values, Array<int>({ 1, 2, 3 }));
+
+        // Empty batches are not emitted
+        scheduler.advanceBy(RelativeTime::milliseconds(20));
+        subject.onNext(4);
+        scheduler.advanceBy(RelativeTime::milliseconds(20));
+
+        ReaX_RequireValues(values, Array<int>({ 1, 2, 3 }), Array<int>({ 4 }));
+    }
+
+    IT("emits the batch early if it has enough values")
+    {
+        ReaX_CollectValues(subject.bufferWithTimeOrCount(RelativeTime::seconds(10), 2), values);
+
+        for (int i : { 1, 2, 3 })
+            subject.onNext(i);
+
+        ReaX_CheckValues(values, Array<int>({ 1, 2 }));
+
+        subject.onCompleted();
+
+        ReaX_RequireValues(values, Array<int>({ 1, 2 }), Array<int>({ 3 }));
+    }
+}
+
+
 TEST_CASE("Observable::combineLatest",
           "[Observable][Observable::combineLatest]")
 {
@@ -88,6 +221,58 @@ TEST_CASE("Observable::combineLatest",
                          std::make_tuple(true, "World", 5),
                          std::make_tuple(true, "World", 6));
     }
+
+    IT("combines an Array of any number of Observables")
+    {
+        OwnedArray<PublishSubject<int>> subjects;
+        Array<Observable<int>> observables;
+
+        for (int i = 0; i < 200; i++)
+            observables.add(*subjects.add(new PublishSubject<int>()));
+
+        Array<Array<int>> values;
+        ReaX_CollectValues(Observable<int>::combineLatest(observables), values);
+
+        // Should only emit when each Observable has emitted a value
+        for (int i = 0; i < 199; i++)
+            subjects[i]->onNext(i);
+
+        CHECK(values.isEmpty());
+        subjects[199]->onNext(199);
+        REQUIRE(values.size() == 1);
+        CHECK(values.getLast().size() == 200);
+        CHECK(values.getLast()[17] == 17);
+
+        // Afterwards, each change should emit once
+        subjects[17]->onNext(-17);
+        REQUIRE(values.size() == 2);
+        CHECK(values.getLast()[17] == -17);
+        CHECK(values.getLast()[18] == 18);
+        CHECK(values.getLast()[199] == 199);
+    }
+
+    IT("completes when all Observables in the Array have completed")
+    {
+        PublishSubject<int> first;
+        PublishSubject<int> second;
+        bool completed = false;
+        Observable<int>::combineLatest({ first, second }).subscribe([](const Array<int>&) {}, [](std::exception_ptr) {}, [&]() { completed = true; });
+
+        first.onNext(1);
+        second.onNext(2);
+        first.onCompleted();
+        CHECK(!completed);
+        second.onCompleted();
+        REQUIRE(completed);
+    }
+
+    IT("completes immediately for an empty Array")
+    {
+        bool completed = false;
+        Observable<int>::combineLatest(Array<Observable<int>>()).subscribe([](const Array<int>&) {}, [](std::exception_ptr) {}, [&]() { completed = true; });
+
+        REQUIRE(completed);
+    }
 }
 
 
@@ -104,6 +289,51 @@ TEST_CASE("Observable::concat",
 
         ReaX_RequireValues(values, var("Hello"), var("World"), var(1.5), var(2.32), var(5.6));
     }
+
+    IT("concatenates an Array of any number of Observables")
+    {
+        Array<Observable<var>> observables;
+
+        for (int i = 0; i < 100; i++)
+            observables.add(Observable<var>::just(i));
+
+        ReaX_CollectValues(Observable<var>::concat(observables), values);
+
+        REQUIRE(values.size() == 100);
+        CHECK(values.getFirst() == var(0));
+        CHECK(values.getLast() == var(99));
+    }
+
+    IT("subscribes to the next Observable in the Array when the previous one has completed")
+    {
+        PublishSubject<var> first;
+        PublishSubject<var> second;
+        ReaX_CollectValues(Observable<var>::concat({ Observable<var>(first), second.take(1), Observable<var>::just("end") }), values);
+
+        second.onNext("ignored");
+        first.onNext(1);
+        first.onCompleted();
+        second.onNext(2);
+        second.onNext(3);
+
+        ReaX_RequireValues(values, var(1), var(2), var("end"));
+    }
+
+    IT("doesn't keep a teardown for each Observable that has completed")
+    {
+        // Uses the push core directly, to see the teardowns of the subscription
+        typedef detail::PushSource<int>::Ptr Source;
+        const Source never(new detail::PushTerminalSource<int>(detail::PushTerminalSource<int>::Kind::Never));
+        std::vector<Source> sources(1000, Source(new detail::PushTerminalSource<int>(detail::PushTerminalSource<int>::Kind::Empty)));
+        sources.push_back(never);
+
+        const auto withoutCompleted = detail::pushSubscribe<int>(Source(new detail::PushConcatSource<int>({ never })), [](const int&) {}, [](std::exception_ptr) {}, []() {});
+        const auto subscription = detail::pushSubscribe<int>(Source(new detail::PushConcatSource<int>(sources)), [](const int&) {}, [](std::exception_ptr) {}, []() {});
+
+        REQUIRE(subscription->getNumTeardowns() == withoutCompleted->getNumTeardowns());
+        withoutCompleted->unsubscribe();
+        subscription->unsubscribe();
+    }
 }
 
 
@@ -236,6 +466,124 @@ TEST_CASE("Observable::flatMap",
 
         ReaX_RequireValues(values, "hello", "HELLO!", "world", "WORLD!");
     }
+
+    IT("subscribes to at most maxConcurrent returned Observables at the same time")
+    {
+        PublishSubject<String> requests;
+        OwnedArray<PublishSubject<String>> loads;
+        bool completed = false;
+
+        requests.flatMap([&loads](String) { return Observable<String>(*loads.add(new PublishSubject<String>())); }, 2)
+            .subscribe([&values](String s) { values.add(s); }, [](std::exception_ptr) {}, [&]() { completed = true; });
+
+        for (int i = 0; i < 5; i++)
+            requests.onNext(String(i));
+
+        // Only calls the function for the first two requests
+        CHECK(loads.size() == 2);
+
+        loads[1]->onNext("b");
+        loads[1]->onCompleted();
+        CHECK(loads.size() == 3);
+
+        loads[0]->onNext("a");
+        loads[0]->onCompleted();
+        loads[2]->onNext("c");
+        requests.onCompleted();
+        loads[2]->onCompleted();
+
+        CHECK(loads.size() == 5);
+        CHECK(!completed);
+        loads[3]->onCompleted();
+        loads[4]->onCompleted();
+
+        CHECK(completed);
+        ReaX_RequireValues(values, "b", "a", "c");
+    }
+
+    IT("doesn't keep a teardown for each returned Observable that has completed")
+    {
+        // Uses the push core directly, to see the teardowns of the subscription
+        typedef detail::PushSource<int>::Ptr Source;
+        const detail::PushSubject<int>::Ptr requests(new detail::PushSubject<int>());
+        const Source flattened(new detail::PushFlatMapSource<int, int>(Source(requests.get()), [](const int&) {
+            return Source(new detail::PushTerminalSource<int>(detail::PushTerminalSource<int>::Kind::Empty));
+        }, 0, 0));
+        const auto subscription = detail::pushSubscribe<int>(flattened, [](const int&) {}, [](std::exception_ptr) {}, []() {});
+        const size_t numTeardowns = subscription->getNumTeardowns();
+
+        for (int i = 0; i < 1000; i++)
+            requests->onNext(i);
+
+        REQUIRE(subscription->getNumTeardowns() == numTeardowns);
+        subscription->unsubscribe();
+    }
+}
+
+
+TEST_CASE("Observable::concatMap",
+          "[Observable][Observable::concatMap]")
+{
+    Array<String> values;
+
+    IT("emits the values from one returned Observable after the other")
+    {
+        PublishSubject<String> first;
+        PublishSubject<String> second;
+        Array<Observable<String>> returned = { first, second };
+        int numCalls = 0;
+
+        ReaX_CollectValues(Observable<int>::from({ 0, 1 }).concatMap([&](int i) -> Observable<String> { numCalls++; return returned[i]; }), values);
+
+        CHECK(numCalls == 1);
+        second.onNext("ignored");
+        first.onNext("a");
+        first.onCompleted();
+        CHECK(numCalls == 2);
+        second.onNext("b");
+
+        ReaX_RequireValues(values, "a", "b");
+    }
+
+    IT("doesn't recurse deeply for many Observables that complete synchronously")
+    {
+        Array<int> numbers;
+        for (int i = 0; i < 10000; i++)
+            numbers.add(i);
+
+        int sum = 0;
+        Observable<int>::from(numbers).concatMap([](int i) { return Observable<int>::just(i % 2); }).subscribe([&sum](int i) { sum += i; });
+
+        REQUIRE(sum == 5000);
+    }
+
+    IT("lets this Observable emit only prefetch values ahead, if it supports flow control")
+    {
+        int numEmitted = 0;
+        auto requests = Observable<int>::create([&numEmitted](const Observer<int>& observer) {
+            const auto emit = [&numEmitted, observer]() {
+                while (observer.hasDemand() && numEmitted < 100)
+                    observer.onNext(numEmitted++);
+            };
+
+            observer.setOnRequest(emit);
+            emit();
+        });
+        OwnedArray<PublishSubject<String>> loads;
+
+        ReaX_CollectValues(requests.concatMap([&loads](int) { return Observable<String>(*loads.add(new PublishSubject<String>())); }, 2), values);
+
+        // One value for the subscribed Observable, and two queued ones
+        CHECK(loads.size() == 1);
+        CHECK(numEmitted == 3);
+
+        loads[0]->onNext("a");
+        loads[0]->onCompleted();
+
+        CHECK(loads.size() == 2);
+        REQUIRE(numEmitted == 4);
+        ReaX_RequireValues(values, "a");
+    }
 }
 
 
@@ -252,6 +600,24 @@ TEST_CASE("Observable::map",
 
         ReaX_RequireValues(values, 6.0, 9.0, 10.5);
     }
+
+    IT("doesn't change an Observable when another operator is appended to it")
+    {
+        auto mapped = source.map([](long l) { return l * 2; });
+        auto filtered = mapped.filter([](long l) { return l > 10; });
+        auto mappedAgain = mapped.map([](long l) { return l + 1; });
+
+        Array<long> filteredValues;
+        ReaX_CollectValues(filtered, filteredValues);
+        ReaX_CollectValues(mappedAgain, values);
+        ReaX_CheckValues(filteredValues, 12, 14);
+        ReaX_CheckValues(values, 9, 13, 15);
+
+        values.clear();
+        ReaX_CollectValues(mapped, values);
+
+        ReaX_RequireValues(values, 8, 12, 14);
+    }
 }
 
 
@@ -319,6 +685,101 @@ TEST_CASE("Observable::merge",
         CHECK(values.size() == 44);
         ReaX_RequireValues(values, 0, 1, -1, 0, 1, -2, -1, 0, 1, -3, -2, -1, 0, 1, -4, -3, -2, -1, 0, 1, -5, -4, -3, -2, -1, 0, 1, -6, -5, -4, -3, -2, -1, 0, 1, -7, -6, -5, -4, -3, -2, -1, 0, 1);
     }
+
+    IT("merges an Array of any number of Observables")
+    {
+        OwnedArray<PublishSubject<int>> subjects;
+        Array<Observable<int>> observables;
+
+        for (int i = 0; i < 200; i++)
+            observables.add(*subjects.add(new PublishSubject<int>()));
+
+        bool completed = false;
+        Observable<int>::merge(observables).subscribe([&values](int value) { values.add(value); }, [](std::exception_ptr) {}, [&]() { completed = true; });
+
+        subjects[150]->onNext(150);
+        subjects[3]->onNext(3);
+
+        for (auto subject : subjects)
+            subject->onCompleted();
+
+        ReaX_CheckValues(values, 150, 3);
+        REQUIRE(completed);
+    }
+
+    IT("keeps emitting when one of the Observables completes early")
+    {
+        PublishSubject<int> first;
+        PublishSubject<int> second;
+        ReaX_CollectValues(Observable<int>::merge({ first.take(1), Observable<int>(second) }), values);
+
+        first.onNext(1);
+        first.onNext(2);
+        second.onNext(3);
+
+        ReaX_RequireValues(values, 1, 3);
+    }
+}
+
+
+TEST_CASE("Observable::publish",
+          "[Observable][Observable::publish]")
+{
+    PublishSubject<int> subject;
+    Array<int> values;
+    int numCalls = 0;
+    auto published = subject.map([&numCalls](int i) { numCalls++; return i * 2; }).publish();
+
+    IT("doesn't emit before connecting")
+    {
+        ReaX_CollectValues(published, values);
+
+        subject.onNext(1);
+
+        CHECK(values.isEmpty());
+        REQUIRE(numCalls == 0);
+    }
+
+    IT("emits to all subscribers after connecting, and calls the map function once per value")
+    {
+        Array<int> otherValues;
+        ReaX_CollectValues(published, values);
+        ReaX_CollectValues(published, otherValues);
+        const auto connection = published.connect();
+
+        subject.onNext(1);
+        subject.onNext(2);
+
+        ReaX_CheckValues(values, 2, 4);
+        ReaX_CheckValues(otherValues, 2, 4);
+        REQUIRE(numCalls == 2);
+
+        connection.unsubscribe();
+    }
+
+    IT("stops emitting after disconnecting")
+    {
+        ReaX_CollectValues(published, values);
+        const auto connection = published.connect();
+
+        subject.onNext(1);
+        connection.unsubscribe();
+        subject.onNext(2);
+
+        ReaX_RequireValues(values, 2);
+    }
+
+    IT("connects only once when calling connect multiple times")
+    {
+        ReaX_CollectValues(published, values);
+        const auto connection = published.connect();
+        published.connect();
+
+        subject.onNext(3);
+
+        ReaX_RequireValues(values, 6);
+        connection.unsubscribe();
+    }
 }
 
 
@@ -357,6 +818,112 @@ TEST_CASE("Observable::scan",
 }
 
 
+TEST_CASE("Observable::share",
+          "[Observable][Observable::share]")
+{
+    PublishSubject<int> subject;
+    Array<int> values;
+    Array<int> otherValues;
+    int numCalls = 0;
+    auto shared = subject.map([&numCalls](int i) { numCalls++; return i + 1; }).share();
+
+    IT("runs the upstream operators once per value for all subscribers")
+    {
+        ReaX_CollectValues(shared, values);
+        ReaX_CollectValues(shared, otherValues);
+
+        subject.onNext(1);
+        subject.onNext(2);
+
+        ReaX_CheckValues(values, 2, 3);
+        ReaX_CheckValues(otherValues, 2, 3);
+        REQUIRE(numCalls == 2);
+    }
+
+    IT("unsubscribes from the source when the last subscriber unsubscribes")
+    {
+        auto subscription = shared.subscribe([&](int i) { values.add(i); });
+        auto otherSubscription = shared.subscribe([&](int i) { otherValues.add(i); });
+
+        subject.onNext(1);
+        subscription.unsubscribe();
+        subject.onNext(2);
+        otherSubscription.unsubscribe();
+        subject.onNext(3);
+
+        ReaX_CheckValues(values, 2);
+        ReaX_CheckValues(otherValues, 2, 3);
+        REQUIRE(numCalls == 2);
+    }
+
+    IT("subscribes again when a new subscriber subscribes after the source has completed")
+    {
+        auto o = Observable<int>::from({ 4, 5 }).share();
+        ReaX_CollectValues(o, values);
+        ReaX_CollectValues(o, otherValues);
+
+        ReaX_CheckValues(values, 4, 5);
+        ReaX_RequireValues(otherValues, 4, 5);
+    }
+
+    IT("calls the create function only once for all subscribers")
+    {
+        int numSubscriptions = 0;
+        auto o = Observable<int>::create([&numSubscriptions](const Observer<int>& observer) {
+            numSubscriptions++;
+            observer.onNext(numSubscriptions);
+        }).share();
+
+        ReaX_CollectValues(o, values);
+        ReaX_CollectValues(o, otherValues);
+
+        ReaX_CheckValues(values, 1);
+        CHECK(otherValues.isEmpty());
+        REQUIRE(numSubscriptions == 1);
+    }
+}
+
+
+TEST_CASE("Observable::shareReplay",
+          "[Observable][Observable::shareReplay]")
+{
+    PublishSubject<int> subject;
+    Array<int> values;
+    int numCalls = 0;
+    auto shared = subject.map([&numCalls](int i) { numCalls++; return i * 10; }).shareReplay(2);
+
+    IT("emits the most recent values to new subscribers")
+    {
+        Array<int> earlyValues;
+        ReaX_CollectValues(shared, earlyValues);
+
+        for (int i : { 1, 2, 3 })
+            subject.onNext(i);
+
+        ReaX_CollectValues(shared, values);
+        subject.onNext(4);
+
+        ReaX_CheckValues(earlyValues, 10, 20, 30, 40);
+        ReaX_CheckValues(values, 20, 30, 40);
+        REQUIRE(numCalls == 4);
+    }
+
+    IT("emits a single most recent value by default")
+    {
+        auto latest = subject.shareReplay();
+        Array<int> earlyValues;
+        ReaX_CollectValues(latest, earlyValues);
+
+        subject.onNext(1);
+        subject.onNext(2);
+
+        ReaX_CollectValues(latest, values);
+
+        ReaX_RequireValues(values, 2);
+    }
+}
+
+
 TEST_CASE("Observable::skip",
           "[Observable][Observable::skip]")
 {
@@ -417,6 +984,81 @@ TEST_CASE("Observable::startWith",
 }
 
 
+TEST_CASE("Observable::switchMap",
+          "[Observable][Observable::switchMap]")
+{
+    Array<String> values;
+
+    IT("only emits the values from the latest returned Observable")
+    {
+        PublishSubject<String> selections;
+        OwnedArray<PublishSubject<String>> previews;
+        bool completed = false;
+
+        selections.switchMap([&previews](String) { return Observable<String>(*previews.add(new PublishSubject<String>())); })
+            .subscribe([&values](String s) { values.add(s); }, [](std::exception_ptr) {}, [&]() { completed = true; });
+
+        selections.onNext("first");
+        previews[0]->onNext("a");
+        selections.onNext("second");
+        previews[0]->onNext("ignored");
+        previews[1]->onNext("b");
+
+        selections.onCompleted();
+        CHECK(!completed);
+        previews[1]->onCompleted();
+
+        CHECK(completed);
+        ReaX_RequireValues(values, "a", "b");
+    }
+
+    IT("doesn't keep a teardown for each returned Observable that it has switched away from")
+    {
+        // Uses the push core directly, to see the teardowns of the subscription
+        typedef detail::PushSource<int>::Ptr Source;
+        const detail::PushSubject<int>::Ptr selections(new detail::PushSubject<int>());
+        const Source switched(new detail::PushSwitchMapSource<int, int>(Source(selections.get()), [](const int&) {
+            return Source(new detail::PushSubject<int>());
+        }));
+        const auto subscription = detail::pushSubscribe<int>(switched, [](const int&) {}, [](std::exception_ptr) {}, []() {});
+        const size_t numTeardowns = subscription->getNumTeardowns();
+
+        for (int i = 0; i < 1000; i++)
+            selections->onNext(i);
+
+        // Only the latest returned Observable is still subscribed
+        REQUIRE(subscription->getNumTeardowns() == numTeardowns + 1);
+        subscription->unsubscribe();
+    }
+
+    IT("ignores an error from a returned Observable that it has switched away from")
+    {
+        // Uses the push core directly, so the returned sources can keep notifying after they have been unsubscribed
+        typedef detail::PushSource<String>::Ptr Source;
+        std::vector<detail::PushObserver<String>::Ptr> previews;
+        const detail::PushSubject<int>::Ptr selections(new detail::PushSubject<int>());
+        const Source switched(new detail::PushSwitchMapSource<int, String>(detail::PushSource<int>::Ptr(selections.get()), [&previews](const int&) {
+            return Source(new detail::PushCreateSource<String>([&previews](const detail::PushObserver<String>::Ptr& observer, const detail::PushSubscription::Ptr&) {
+                previews.push_back(observer);
+            }));
+        }));
+        bool onErrorCalled = false;
+        const auto subscription = detail::pushSubscribe<String>(switched, [&](const String& s) { values.add(s); }, [&](std::exception_ptr) { onErrorCalled = true; }, []() {});
+
+        selections->onNext(1);
+        selections->onNext(2);
+        previews[0]->onError(std::make_exception_ptr(std::runtime_error("Error!")));
+        previews[1]->onNext("b");
+
+        CHECK(!onErrorCalled);
+        ReaX_CheckValues(values, "b");
+
+        previews[1]->onError(std::make_exception_ptr(std::runtime_error("Error!")));
+        REQUIRE(onErrorCalled);
+    }
+}
+
+
 TEST_CASE("Observable::takeLast",
           "[Observable][Observable::takeLast]")
 {
@@ -491,6 +1133,118 @@ TEST_CASE("Observable::takeWhile",
 }
 
 
+TEST_CASE("Chains of Observable::map, Observable::filter and Observable::takeWhile",
+          "[Observable][Observable::map][Observable::filter][Observable::takeWhile]")
+{
+    PublishSubject<int> subject;
+    Array<String> values;
+
+    IT("applies the stages in order")
+    {
+        auto chained = subject.map([](int i) { return i * 2; })
+                           .filter([](int i) { return i != 4; })
+                           .map([](int i) { return String(i) + "!"; })
+                           .takeWhile([](String s) { return s != "8!"; });
+        ReaX_CollectValues(chained, values);
+
+        for (int i : { 1, 2, 3, 4, 1 })
+            subject.onNext(i);
+
+        ReaX_RequireValues(values, "2!", "6!");
+    }
+
+    IT("notifies onCompleted when takeWhile stops")
+    {
+        bool completed = false;
+        subject.map([](int i) { return i + 1; })
+            .takeWhile([](int i) { return i < 3; })
+            .subscribe([](int) {}, [](std::exception_ptr) {}, [&]() { completed = true; });
+
+        subject.onNext(1);
+        CHECK(!completed);
+        subject.onNext(2);
+
+        REQUIRE(completed);
+    }
+
+    IT("doesn't call the stages after takeWhile has stopped")
+    {
+        int numCalls = 0;
+        Array<int> emitted;
+        bool completed = false;
+        Observable<int>::from({ 1, 5, 1, 6 })
+            .takeWhile([](int i) { return i < 3; })
+            .map([&](int i) {
+                numCalls++;
+                return i * 10;
+            })
+            .subscribe([&](int i) { emitted.add(i); }, [](std::exception_ptr) {}, [&]() {
+                CHECK(!completed);
+                completed = true;
+            });
+
+        CHECK(numCalls == 1);
+        CHECK(completed);
+        ReaX_RequireValues(emitted, 10);
+    }
+
+    IT("notifies onError if a stage throws")
+    {
+        bool onErrorCalled = false;
+        subject.map([](int i) { return i; })
+            .filter([](int) -> bool { throw std::runtime_error("Error!"); })
+            .subscribe([](int) {}, [&](std::exception_ptr) { onErrorCalled = true; });
+
+        subject.onNext(1);
+
+        REQUIRE(onErrorCalled);
+    }
+
+    IT("doesn't affect other chains with the same beginning")
+    {
+        const auto doubled = subject.map([](int i) { return i * 2; });
+        Array<int> filtered;
+        Array<int> mapped;
+        ReaX_CollectValues(doubled.filter([](int i) { return i > 2; }), filtered);
+        ReaX_CollectValues(doubled.map([](int i) { return i + 1; }), mapped);
+
+        subject.onNext(1);
+        subject.onNext(2);
+
+        ReaX_CheckValues(filtered, 4);
+        ReaX_RequireValues(mapped, 3, 5);
+    }
+}
+
+
+TEST_CASE("Observable::window",
+          "[Observable][Observable::window]")
+{
+    Array<Array<int>> values;
+
+    IT("emits overlapping windows")
+    {
+        ReaX_CollectValues(Observable<int>::range(1, 6).window(4, 2), values);
+
+        ReaX_RequireValues(values, Array<int>({ 1, 2, 3, 4 }), Array<int>({ 3, 4, 5, 6 }));
+    }
+
+    IT("emits a sliding window for each value by default")
+    {
+        ReaX_CollectValues(Observable<int>::range(1, 4).window(3), values);
+
+        ReaX_RequireValues(values, Array<int>({ 1, 2, 3 }), Array<int>({ 2, 3, 4 }));
+    }
+
+    IT("drops values between windows if skip is larger than count")
+    {
+        ReaX_CollectValues(Observable<int>::range(1, 8).window(2, 3), values);
+
+        ReaX_RequireValues(values, Array<int>({ 1, 2 }), Array<int>({ 4, 5 }), Array<int>({ 7, 8 }));
+    }
+}
+
+
 TEST_CASE("Observable::withLatestFrom",
           "[Observable][Observable::withLatestFrom]")
 {
@@ -544,4 +1298,39 @@ TEST_CASE("Observable::zip",
         strings.onNext("x");
         ReaX_RequireValues(values, "s=a; i=1; d=0.1", "s=x; i=57; d=0.25");
     }
+
+    IT("zips an Array of any number of Observables")
+    {
+        OwnedArray<PublishSubject<int>> subjects;
+        Array<Observable<int>> observables;
+
+        for (int i = 0; i < 100; i++)
+            observables.add(*subjects.add(new PublishSubject<int>()));
+
+        Array<Array<int>> zipped;
+        ReaX_CollectValues(Observable<int>::zip(observables), zipped);
+
+        for (int i = 0; i < 100; i++) {
+            subjects[i]->onNext(i);
+            subjects[i]->onNext(i * 10);
+        }
+
+        REQUIRE(zipped.size() == 2);
+        CHECK(zipped[0][42] == 42);
+        CHECK(zipped[1][42] == 420);
+    }
+
+    IT("completes when an Observable in the Array has completed and all its values have been zipped")
+    {
+        PublishSubject<int> first;
+        PublishSubject<int> second;
+        bool completed = false;
+        Observable<int>::zip({ first, second }).subscribe([](const Array<int>&) {}, [](std::exception_ptr) {}, [&]() { completed = true; });
+
+        first.onNext(1);
+        first.onCompleted();
+        CHECK(!completed);
+        second.onNext(2);
+        REQUIRE(completed);
+    }
 }
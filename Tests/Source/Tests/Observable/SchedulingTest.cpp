@@ -1,5 +1,7 @@
 #include "../../Other/TestPrefix.h"
 
+#include <thread>
+
 
 TEST_CASE("Observable::observeOn",
           "[Observable][Observable::observeOn]")
@@ -49,6 +51,50 @@ TEST_CASE("Observable::observeOn",
         ReaX_RequireValues(values, 24, 48, 72);
     }
 
+    IT("reuses threads for Scheduler::newThread")
+    {
+        const int numThreadsBefore = Scheduler::getNumThreadsCreated();
+
+        for (int i = 0; i < 20; i++)
+            values = observable.observeOn(Scheduler::newThread()).toArray();
+
+        ReaX_RequireValues(values, 1, 2, 3);
+        REQUIRE(Scheduler::getNumThreadsCreated() - numThreadsBefore < 20);
+    }
+
+    IT("can schedule to a thread pool")
+    {
+        const auto pool = Scheduler::threadPool(4);
+        Thread::ThreadID poolThreadID = nullptr;
+
+        auto onPool = Observable<int>::range(1, 1000).observeOn(pool).map([&](int i) {
+            poolThreadID = Thread::getCurrentThreadId();
+            return i;
+        });
+
+        // Wait blocking. The values arrive in order, because the subscription is serialized.
+        values = onPool.toArray();
+
+        REQUIRE(poolThreadID != nullptr);
+        REQUIRE(poolThreadID != Thread::getCurrentThreadId());
+        REQUIRE(values.size() == 1000);
+
+        for (int i = 0; i < values.size(); i++)
+            REQUIRE(values[i] == i + 1);
+    }
+
+    IT("can schedule to a thread pool with thread options")
+    {
+        ThreadOptions options;
+        options.name = "Analysis";
+        options.priority = ThreadPriority::Low;
+        options.affinityMask = 1;
+
+        values = observable.observeOn(Scheduler::threadPool(2, options)).toArray();
+
+        ReaX_RequireValues(values, 1, 2, 3);
+    }
+
     IT("can schedule to the message thread")
     {
         auto onMessageThread = observable.observeOn(Scheduler::messageThread()).map([](int i) {
@@ -64,4 +110,387 @@ TEST_CASE("Observable::observeOn",
 
         ReaX_RequireValues(values, 2, 4, 6);
     }
+
+    IT("emits a burst of values from one dispatch")
+    {
+        PublishSubject<int> subject;
+        ReaX_CollectValues(subject.observeOn(Scheduler::messageThread()), values);
+
+        for (int i = 0; i < 1000; i++)
+            subject.onNext(i);
+
+        // All values are emitted at once, by the first dispatch
+        ReaX_RunDispatchLoopUntil(!values.isEmpty());
+        REQUIRE(values.size() == 1000);
+        REQUIRE(values.getLast() == 999);
+    }
+
+    IT("emits a burst of values from another thread with one drain")
+    {
+        PublishSubject<int> subject;
+        ReaX_CollectValues(subject.observeOn(Scheduler::messageThread()), values);
+        const DrainMetrics before = Scheduler::getMessageThreadMetrics();
+
+        std::thread producer([&subject]() {
+            for (int i = 0; i < 1000; i++)
+                subject.onNext(i);
+        });
+        producer.join();
+
+        ReaX_RunDispatchLoopUntil(values.size() == 1000);
+        REQUIRE(values.getLast() == 999);
+
+        // All values were queued before the first drain. Other tests may have left a few items behind.
+        REQUIRE(Scheduler::getMessageThreadMetrics().numItems - before.numItems < 10);
+    }
+
+    IT("doesn't hold the message thread if values keep arriving while emitting")
+    {
+        PublishSubject<int> subject;
+
+        // Each value causes another one, so the queue never runs empty
+        const auto subscription = subject.observeOn(Scheduler::messageThread()).subscribe([&](int i) {
+            values.add(i);
+            subject.onNext(i + 1);
+        });
+
+        bool otherMessageDelivered = false;
+        MessageManager::getInstance()->callAsync([&otherMessageDelivered]() { otherMessageDelivered = true; });
+        subject.onNext(0);
+
+        ReaX_RunDispatchLoopUntil(otherMessageDelivered);
+        subscription.unsubscribe();
+
+        REQUIRE(!values.isEmpty());
+    }
+
+    IT("runs at most maxItems drains per message with a DrainBudget")
+    {
+        PublishSubject<int> first;
+        PublishSubject<int> second;
+        ReaX_CollectValues(first.observeOn(Scheduler::messageThread()), values);
+        ReaX_CollectValues(second.observeOn(Scheduler::messageThread()), values);
+
+        DrainBudget budget;
+        budget.maxItems = 1;
+        Scheduler::setMessageThreadBudget(budget);
+        const DrainMetrics before = Scheduler::getMessageThreadMetrics();
+
+        first.onNext(1);
+        second.onNext(2);
+
+        ReaX_RunDispatchLoopUntil(values.size() == 2);
+        Scheduler::setMessageThreadBudget(DrainBudget());
+
+        ReaX_RequireValues(values, 1, 2);
+        REQUIRE(Scheduler::getMessageThreadMetrics().numBudgetExhausted > before.numBudgetExhausted);
+    }
+}
+
+
+TEST_CASE("Observable::observeOn with a bounded queue",
+          "[Observable][Observable::observeOn]")
+{
+    PublishSubject<int> subject;
+    Array<int> values;
+
+    IT("drops new values when the queue is full")
+    {
+        ReaX_CollectValues(subject.observeOn(Scheduler::messageThread(), 3, OverflowStrategy::DropNewest), values);
+
+        for (int i : { 1, 2, 3, 4, 5, 6 })
+            subject.onNext(i);
+
+        ReaX_RunDispatchLoopUntil(values.size() == 3);
+        ReaX_RequireValues(values, 1, 2, 3);
+
+        // The queue has room again
+        subject.onNext(7);
+        ReaX_RunDispatchLoopUntil(values.size() == 4);
+        ReaX_RequireValues(values, 1, 2, 3, 7);
+    }
+
+    IT("drops the oldest values when the queue is full")
+    {
+        ReaX_CollectValues(subject.observeOn(Scheduler::messageThread(), 3, OverflowStrategy::DropOldest), values);
+
+        for (int i : { 1, 2, 3, 4, 5, 6 })
+            subject.onNext(i);
+
+        ReaX_RunDispatchLoopUntil(values.size() == 3);
+        ReaX_RequireValues(values, 4, 5, 6);
+    }
+
+    IT("keeps the latest value when the queue is full")
+    {
+        ReaX_CollectValues(subject.observeOn(Scheduler::messageThread(), 3, OverflowStrategy::Latest), values);
+
+        for (int i : { 1, 2, 3, 4, 5, 6 })
+            subject.onNext(i);
+
+        ReaX_RunDispatchLoopUntil(values.size() == 3);
+        ReaX_RequireValues(values, 1, 2, 6);
+    }
+
+    IT("blocks a producer on another thread until there is room")
+    {
+        auto observable = Observable<int>::range(1, 100).observeOn(Scheduler::newThread()).observeOn(Scheduler::messageThread(), 4, OverflowStrategy::Block);
+        ReaX_CollectValues(observable, values);
+
+        ReaX_RunDispatchLoopUntil(values.size() == 100);
+        REQUIRE(values.getFirst() == 1);
+        REQUIRE(values.getLast() == 100);
+    }
+
+    IT("blocks a producer on another thread of the same pool until there is room")
+    {
+        const auto pool = Scheduler::threadPool(2);
+        ReaX_CollectValues(subject.observeOn(pool, 4, OverflowStrategy::Block).observeOn(Scheduler::messageThread()), values);
+
+        // The subject doesn't support flow control, so it overflows the queue. It emits from an action of another subscription on the pool.
+        const auto emitValues = [&](int) {
+            for (int i = 1; i <= 100; i++)
+                subject.onNext(i);
+        };
+        DisposeBag disposeBag;
+        Observable<int>::just(0).observeOn(pool).subscribe(emitValues).disposedBy(disposeBag);
+
+        ReaX_RunDispatchLoopUntil(values.size() == 100);
+        REQUIRE(values.getFirst() == 1);
+        REQUIRE(values.getLast() == 100);
+    }
+
+    IT("emits onCompleted after the queued values")
+    {
+        bool completed = false;
+        DisposeBag disposeBag;
+        const auto observable = subject.observeOn(Scheduler::messageThread(), 3, OverflowStrategy::DropNewest);
+        observable.subscribe([&](int i) { values.add(i); }, [](std::exception_ptr) {}, [&]() { completed = (values.size() == 2); }).disposedBy(disposeBag);
+
+        subject.onNext(1);
+        subject.onNext(2);
+        subject.onCompleted();
+
+        ReaX_RunDispatchLoopUntil(completed);
+        ReaX_RequireValues(values, 1, 2);
+    }
+}
+
+
+TEST_CASE("Observable::observeOnLatest",
+          "[Observable][Observable::observeOnLatest]")
+{
+    PublishSubject<int> subject;
+    Array<int> values;
+
+    IT("emits only the latest value per dispatch")
+    {
+        ReaX_CollectValues(subject.observeOnLatest(Scheduler::messageThread()), values);
+
+        for (int i = 1; i <= 1000; i++)
+            subject.onNext(i);
+
+        CHECK(values.isEmpty());
+        ReaX_RunDispatchLoopUntil(!values.isEmpty());
+        ReaX_RequireValues(values, 1000);
+
+        subject.onNext(1001);
+        ReaX_RunDispatchLoopUntil(values.size() == 2);
+        ReaX_RequireValues(values, 1000, 1001);
+    }
+
+    IT("emits the latest value before completing")
+    {
+        bool completed = false;
+        DisposeBag disposeBag;
+        subject.observeOnLatest(Scheduler::messageThread()).subscribe([&](int i) { values.add(i); }, [](std::exception_ptr) {}, [&]() { completed = true; }).disposedBy(disposeBag);
+
+        subject.onNext(1);
+        subject.onNext(2);
+        subject.onCompleted();
+
+        ReaX_RunDispatchLoopUntil(completed);
+        ReaX_RequireValues(values, 2);
+    }
+}
+
+TEST_CASE("Observable::subscribeWithDemand",
+          "[Observable][Observable::subscribeWithDemand]")
+{
+    // A producer that supports flow control: It only emits while there's demand
+    int numEmitted = 0;
+    auto observable = Observable<int>::create([&numEmitted](const Observer<int>& observer) {
+        const auto emit = [&numEmitted, observer]() {
+            while (observer.hasDemand() && numEmitted < 10)
+                observer.onNext(numEmitted++);
+
+            if (numEmitted == 10)
+                observer.onCompleted();
+        };
+
+        observer.setOnRequest(emit);
+        emit();
+    });
+    Array<int> values;
+
+    IT("emits only the requested number of values")
+    {
+        const auto subscription = observable.map([](int i) { return i * 2; }).subscribeWithDemand(3, [&](int i) { values.add(i); });
+
+        ReaX_RequireValues(values, 0, 2, 4);
+
+        subscription.request(2);
+        ReaX_RequireValues(values, 0, 2, 4, 6, 8);
+
+        subscription.unsubscribe();
+    }
+
+    IT("completes when all values have been requested")
+    {
+        bool completed = false;
+        const auto subscription = observable.subscribeWithDemand(5, [&](int i) { values.add(i); }, [](std::exception_ptr) {}, [&]() { completed = true; });
+
+        CHECK_FALSE(completed);
+        subscription.request(5);
+        REQUIRE(completed);
+        REQUIRE(values.size() == 10);
+    }
+
+    IT("has unlimited demand with a regular subscribe")
+    {
+        ReaX_CollectValues(observable, values);
+
+        REQUIRE(values.size() == 10);
+    }
+}
+
+TEST_CASE("SchedulerRegistry",
+          "[SchedulerRegistry]")
+{
+    auto observable = Observable<int>::from({ 1, 2, 3 });
+    Array<int> values;
+
+    IT("shares the threads between instances")
+    {
+        std::vector<std::unique_ptr<SchedulerRegistry>> instances;
+        instances.emplace_back(new SchedulerRegistry());
+        values = observable.observeOn(Scheduler::backgroundThread()).toArray();
+        const int numThreadsCreated = Scheduler::getNumThreadsCreated();
+
+        // More instances don't create more threads
+        for (int i = 0; i < 7; i++) {
+            instances.emplace_back(new SchedulerRegistry());
+            values = observable.observeOn(Scheduler::backgroundThread()).toArray();
+        }
+
+        ReaX_RequireValues(values, 1, 2, 3);
+        REQUIRE(SchedulerRegistry::getNumInstances() == 8);
+        REQUIRE(Scheduler::getNumThreadsCreated() == numThreadsCreated);
+
+        instances.clear();
+        REQUIRE(SchedulerRegistry::getNumInstances() == 0);
+    }
+
+    IT("discards pending actions when the last instance is destroyed")
+    {
+        std::unique_ptr<SchedulerRegistry> registry(new SchedulerRegistry());
+        ReaX_CollectValues(observable.observeOn(Scheduler::messageThread()), values);
+
+        registry.reset();
+        ReaX_RunDispatchLoop(20);
+        CHECK(values.isEmpty());
+
+        // Using ReaX afterwards starts new schedulers
+        ReaX_CollectValues(observable.observeOn(Scheduler::messageThread()), values);
+        ReaX_RunDispatchLoopUntil(values.size() == 3);
+        ReaX_RequireValues(values, 1, 2, 3);
+    }
+
+    IT("doesn't start new schedulers to set the message thread budget or get its metrics")
+    {
+        std::unique_ptr<SchedulerRegistry> registry(new SchedulerRegistry());
+        ReaX_CollectValues(observable.observeOn(Scheduler::messageThread()), values);
+        ReaX_RunDispatchLoopUntil(values.size() == 3);
+        CHECK(Scheduler::getMessageThreadMetrics().numItems > 0);
+
+        registry.reset();
+        Scheduler::setMessageThreadBudget(DrainBudget());
+
+        REQUIRE(Scheduler::getMessageThreadMetrics().numItems == 0);
+    }
+}
+
+TEST_CASE("Scheduler::virtualTime",
+          "[Scheduler][Scheduler::virtualTime]")
+{
+    const auto scheduler = Scheduler::virtualTime();
+    PublishSubject<int> subject;
+    Array<int> values;
+
+    IT("emits interval values when the clock is advanced")
+    {
+        ReaX_CollectValues(Observable<int>::interval(RelativeTime::milliseconds(10), scheduler), values);
+        CHECK(values.isEmpty());
+
+        scheduler.advanceBy(RelativeTime::milliseconds(35));
+
+        ReaX_RequireValues(values, 1, 2, 3, 4);
+        REQUIRE(scheduler.getNow().inMilliseconds() == 35);
+    }
+
+    IT("debounces in virtual time")
+    {
+        ReaX_CollectValues(subject.debounce(RelativeTime::milliseconds(100), scheduler), values);
+
+        subject.onNext(1);
+        scheduler.advanceBy(RelativeTime::milliseconds(50));
+        subject.onNext(2);
+        scheduler.advanceBy(RelativeTime::milliseconds(99));
+        CHECK(values.isEmpty());
+
+        scheduler.advanceBy(RelativeTime::milliseconds(1));
+        ReaX_RequireValues(values, 2);
+    }
+
+    IT("debounces many values without waiting in real time")
+    {
+        int numReceived = 0;
+        DisposeBag disposeBag;
+        subject.debounce(RelativeTime::milliseconds(1), scheduler)
+            .subscribe([&numReceived](int) { numReceived++; })
+            .disposedBy(disposeBag);
+
+        // Every other value is followed by a quiet period, so half of the values are emitted
+        for (int i = 0; i < 10000; i++) {
+            subject.onNext(i);
+            scheduler.advanceBy(RelativeTime::milliseconds(i % 2 == 0 ? 0 : 2));
+        }
+
+        REQUIRE(numReceived == 5000);
+        REQUIRE(scheduler.getNow().inMilliseconds() == 10000);
+    }
+
+    IT("samples in virtual time")
+    {
+        ReaX_CollectValues(subject.sample(RelativeTime::milliseconds(100), scheduler), values);
+
+        subject.onNext(1);
+        subject.onNext(2);
+        scheduler.advanceBy(RelativeTime::milliseconds(200));
+        subject.onNext(3);
+        scheduler.advanceBy(RelativeTime::milliseconds(100));
+
+        ReaX_RequireValues(values, 2, 3);
+    }
+
+    IT("observes on the virtual clock")
+    {
+        ReaX_CollectValues(subject.observeOn(scheduler), values);
+
+        subject.onNext(1);
+        CHECK(values.isEmpty());
+
+        scheduler.advanceBy(RelativeTime());
+        ReaX_RequireValues(values, 1);
+    }
 }
@@ -0,0 +1,121 @@
+#include "../../Other/TestPrefix.h"
+
+
+TEST_CASE("simd operators",
+          "[TypedObservable][simd]")
+{
+    TypedPublishSubject<float> subject;
+    const float batch[] = { 1.f, -3.f, 2.f, 0.5f, 4.f, -1.f };
+    Array<float> values;
+
+    IT("transforms a batch with affine, and passes it on as one batch")
+    {
+        Array<int> batchSizes;
+        simd::affine(subject, 2.f, 1.f).subscribeBatches([&](const float* batchValues, size_t numValues) {
+            batchSizes.add(static_cast<int>(numValues));
+            values.addArray(batchValues, static_cast<int>(numValues));
+        });
+
+        subject.onNextBatch(batch, 6);
+        subject.onNext(10.f);
+
+        ReaX_CheckValues(values, 3.f, -5.f, 5.f, 2.f, 9.f, -1.f, 21.f);
+        ReaX_RequireValues(batchSizes, 6, 1);
+    }
+
+    IT("emits the running sum across batches")
+    {
+        ReaX_CollectValues(simd::runningSum(subject, 10.f), values);
+
+        subject.onNextBatch(batch, 3);
+        subject.onNext(5.f);
+        subject.onNextBatch(batch + 3, 3);
+
+        ReaX_RequireValues(values, 11.f, 8.f, 10.f, 15.f, 15.5f, 19.5f, 18.5f);
+    }
+
+    IT("emits the sum, minimum and maximum when the source completes")
+    {
+        Array<float> sums;
+        Array<float> minima;
+        Array<float> maxima;
+        ReaX_CollectValues(simd::sum(subject), sums);
+        ReaX_CollectValues(simd::minimum(subject), minima);
+        ReaX_CollectValues(simd::maximum(subject), maxima);
+
+        subject.onNextBatch(batch, 6);
+        subject.onNext(-7.f);
+
+        CHECK(sums.isEmpty());
+
+        subject.onCompleted();
+
+        ReaX_CheckValues(sums, -3.5f);
+        ReaX_CheckValues(minima, -7.f);
+        ReaX_RequireValues(maxima, 4.f);
+    }
+
+    IT("doesn't emit a minimum or maximum for an empty source")
+    {
+        ReaX_CollectValues(simd::minimum(subject), values);
+        ReaX_CollectValues(simd::maximum(subject), values);
+
+        subject.onCompleted();
+
+        REQUIRE(values.isEmpty());
+    }
+
+    IT("emits the peak level of each window, across batches")
+    {
+        ReaX_CollectValues(simd::peak(subject, 4), values);
+
+        subject.onNextBatch(batch, 3);
+        subject.onNextBatch(batch + 3, 3);
+        subject.onNext(-0.25f);
+        subject.onNext(0.1f);
+
+        ReaX_RequireValues(values, 3.f, 4.f);
+    }
+
+    IT("emits the RMS level of each window, however the values are batched")
+    {
+        Array<double> levels;
+        TypedPublishSubject<double> doubles;
+        ReaX_CollectValues(simd::rms(doubles, 2), levels);
+
+        const double samples[] = { 3.0, -4.0, 3.0, -4.0 };
+        doubles.onNextBatch(samples, 4);
+        doubles.onNext(3.0);
+        doubles.onNext(-4.0);
+
+        REQUIRE(levels.size() == 3);
+
+        for (double level : levels)
+            REQUIRE(level == Approx(std::sqrt(12.5)));
+    }
+
+    IT("supports other arithmetic types with scalar fallbacks")
+    {
+        Array<int> ints;
+        TypedPublishSubject<int> intSubject;
+        ReaX_CollectValues(simd::sum(simd::affine(intSubject, 3, -1)), ints);
+
+        const int intValues[] = { 1, 2, 3, 4, 5 };
+        intSubject.onNextBatch(intValues, 5);
+        intSubject.onCompleted();
+
+        ReaX_RequireValues(ints, 40);
+    }
+
+    IT("processes the values from a LockFreeSource in batches")
+    {
+        LockFreeSource<float> source(16);
+        ReaX_CollectValues(simd::peak(source.asTypedObservable(), 3), values);
+
+        for (auto f : { 0.1f, -0.8f, 0.3f })
+            source.onNext(f, CongestionPolicy::DropOldest);
+
+        ReaX_RunDispatchLoopUntil(!values.isEmpty());
+        ReaX_RequireValues(values, 0.8f);
+    }
+}
@@ -0,0 +1,323 @@
+#include "../../Other/TestPrefix.h"
+
+
+TEST_CASE("TypedObservable creation",
+          "[TypedObservable]")
+{
+    Array<int> values;
+
+    IT("emits values from an Array")
+    {
+        ReaX_CollectValues(TypedObservable<int>::from({ 3, 8, -5 }), values);
+        ReaX_RequireValues(values, 3, 8, -5);
+    }
+
+    IT("emits a single value with just")
+    {
+        ReaX_CollectValues(TypedObservable<int>::just(17), values);
+        ReaX_RequireValues(values, 17);
+    }
+
+    IT("emits values from a TypedObserver")
+    {
+        auto o = TypedObservable<int>::create([](const TypedObserver<int>& observer) {
+            observer.onNext(4);
+            observer.onNext(9);
+            observer.onCompleted();
+        });
+
+        bool completed = false;
+        o.subscribe([&](int i) { values.add(i); }, [](std::exception_ptr) {}, [&]() { completed = true; });
+
+        ReaX_CheckValues(values, 4, 9);
+        REQUIRE(completed);
+    }
+
+    IT("lets a TypedObserver find out that it has been unsubscribed")
+    {
+        int numCalls = 0;
+        auto o = TypedObservable<int>::create([](const TypedObserver<int>& observer) {
+            for (int i = 0; i < 100 && !observer.isUnsubscribed(); i++)
+                observer.onNext(i);
+        });
+
+        o.map([&](int i) { numCalls++; return i; }).take(3).subscribe([&](int i) { values.add(i); });
+
+        ReaX_CheckValues(values, 0, 1, 2);
+        REQUIRE(numCalls == 3);
+    }
+
+    IT("notifies onError if create throws")
+    {
+        auto o = TypedObservable<int>::create([](const TypedObserver<int>&) { throw std::runtime_error("Error!"); });
+
+        REQUIRE_THROWS_WITH(o.subscribe([](int) {}, std::rethrow_exception), "Error!");
+    }
+
+    IT("notifies onError for an error Observable")
+    {
+        bool onErrorCalled = false;
+        TypedObservable<int>::error(std::runtime_error("Error!")).subscribe([](int) {}, [&](std::exception_ptr) { onErrorCalled = true; });
+
+        REQUIRE(onErrorCalled);
+    }
+
+    IT("notifies onCompleted for an empty Observable")
+    {
+        bool completed = false;
+        TypedObservable<int>::empty().subscribe([](int) {}, [](std::exception_ptr) {}, [&]() { completed = true; });
+
+        REQUIRE(completed);
+    }
+
+    IT("doesn't notify anything for a never Observable")
+    {
+        bool notified = false;
+        TypedObservable<int>::never().subscribe([&](int) { notified = true; }, [&](std::exception_ptr) { notified = true; }, [&]() { notified = true; });
+
+        REQUIRE(!notified);
+    }
+}
+
+TEST_CASE("TypedObservable operators",
+          "[TypedObservable]")
+{
+    TypedPublishSubject<int> subject;
+
+    IT("chains map and filter without changing the values")
+    {
+        Array<String> values;
+        ReaX_CollectValues(subject.map([](int i) { return i * 10; }).filter([](int i) { return i != 20; }).map([](int i) { return String(i) + "!"; }), values);
+
+        for (int i : { 1, 2, 3 })
+            subject.onNext(i);
+
+        ReaX_RequireValues(values, "10!", "30!");
+    }
+
+    IT("supports scan and reduce")
+    {
+        Array<int> scanned;
+        Array<int> reduced;
+        ReaX_CollectValues(subject.scan(10, [](int accumulator, int i) { return accumulator + i; }), scanned);
+        ReaX_CollectValues(subject.reduce(10, [](int accumulator, int i) { return accumulator + i; }), reduced);
+
+        for (int i : { 1, 2, 3 })
+            subject.onNext(i);
+
+        ReaX_CheckValues(scanned, 11, 13, 16);
+        CHECK(reduced.isEmpty());
+
+        subject.onCompleted();
+
+        ReaX_RequireValues(reduced, 16);
+    }
+
+    IT("supports distinctUntilChanged")
+    {
+        Array<int> values;
+        ReaX_CollectValues(subject.distinctUntilChanged(), values);
+
+        for (int i : { 3, 3, 4, 4, 3 })
+            subject.onNext(i);
+
+        ReaX_RequireValues(values, 3, 4, 3);
+    }
+
+    IT("supports skip, take and takeWhile")
+    {
+        Array<int> skipped;
+        Array<int> taken;
+        Array<int> takenWhile;
+        ReaX_CollectValues(subject.skip(2), skipped);
+        ReaX_CollectValues(subject.take(2), taken);
+        ReaX_CollectValues(subject.takeWhile([](int i) { return i < 3; }), takenWhile);
+
+        for (int i : { 1, 2, 3, 1 })
+            subject.onNext(i);
+
+        ReaX_CheckValues(skipped, 3, 1);
+        ReaX_CheckValues(taken, 1, 2);
+        ReaX_RequireValues(takenWhile, 1, 2);
+    }
+
+    IT("notifies onError if an operator function throws")
+    {
+        bool onErrorCalled = false;
+        subject.map([](int) -> int { throw std::runtime_error("Error!"); }).subscribe([](int) {}, [&](std::exception_ptr) { onErrorCalled = true; });
+
+        subject.onNext(1);
+
+        REQUIRE(onErrorCalled);
+    }
+
+    IT("stops emitting after unsubscribing")
+    {
+        Array<int> values;
+        auto subscription = subject.subscribe([&](int i) { values.add(i); });
+
+        subject.onNext(1);
+        subscription.unsubscribe();
+        subject.onNext(2);
+
+        ReaX_RequireValues(values, 1);
+    }
+}
+
+TEST_CASE("TypedObservable batches",
+          "[TypedObservable]")
+{
+    TypedPublishSubject<int> subject;
+    const int batch[] = { 1, 2, 3, 4, 5, 6 };
+    Array<int> values;
+    Array<int> batchSizes;
+    auto collectBatches = [&](const int* batchValues, size_t numValues) {
+        batchSizes.add(static_cast<int>(numValues));
+        values.addArray(batchValues, static_cast<int>(numValues));
+    };
+
+    IT("passes a mapped and scanned batch on as one batch")
+    {
+        subject.map([](int i) { return i * 10; }).scan(0, [](int accumulator, int i) { return accumulator + i; }).subscribeBatches(collectBatches);
+
+        subject.onNextBatch(batch, 6);
+
+        ReaX_CheckValues(values, 10, 30, 60, 100, 150, 210);
+        ReaX_RequireValues(batchSizes, 6);
+    }
+
+    IT("passes on runs of values that pass a filter without copying them")
+    {
+        subject.filter([](int i) { return i % 3 != 0; }).subscribeBatches(collectBatches);
+
+        subject.onNextBatch(batch, 6);
+
+        ReaX_CheckValues(values, 1, 2, 4, 5);
+        ReaX_RequireValues(batchSizes, 2, 2);
+    }
+
+    IT("ends a batch early with take and takeWhile")
+    {
+        Array<int> takenWhile;
+        bool completed = false;
+        subject.skip(1).take(3).subscribeBatches(collectBatches, [](std::exception_ptr) {}, [&]() { completed = true; });
+        ReaX_CollectValues(subject.takeWhile([](int i) { return i < 3; }), takenWhile);
+
+        subject.onNextBatch(batch, 6);
+        subject.onNextBatch(batch, 6);
+
+        ReaX_CheckValues(values, 2, 3, 4);
+        ReaX_CheckValues(batchSizes, 3);
+        ReaX_CheckValues(takenWhile, 1, 2);
+        REQUIRE(completed);
+    }
+
+    IT("ignores values after takeWhile has stopped, if the operator before it doesn't support batches")
+    {
+        int numPredicateCalls = 0;
+        int numCompletions = 0;
+        subject.distinctUntilChanged()
+            .takeWhile([&](int i) {
+                numPredicateCalls++;
+                return i < 3;
+            })
+            .subscribeBatches(collectBatches, [](std::exception_ptr) {}, [&]() { numCompletions++; });
+
+        subject.onNextBatch(batch, 6);
+
+        ReaX_CheckValues(values, 1, 2);
+        CHECK(numPredicateCalls == 3);
+        REQUIRE(numCompletions == 1);
+    }
+
+    IT("emits the values before a failing one, and then notifies onError")
+    {
+        bool onErrorCalled = false;
+        subject.map([](int i) { return (i < 3 ? i : throw std::runtime_error("Error!")); }).subscribeBatches(collectBatches, [&](std::exception_ptr) { onErrorCalled = true; });
+
+        subject.onNextBatch(batch, 6);
+
+        ReaX_CheckValues(values, 1, 2);
+        REQUIRE(onErrorCalled);
+    }
+
+    IT("emits a batch one value at a time to subscribers that don't support batches")
+    {
+        Array<int> boxed;
+        ReaX_CollectValues(subject.map([](int i) { return i + 1; }), values);
+        ReaX_CollectValues(subject.asObservable(), boxed);
+
+        subject.onNextBatch(batch, 3);
+
+        ReaX_CheckValues(values, 2, 3, 4);
+        ReaX_RequireValues(boxed, 1, 2, 3);
+    }
+
+    IT("passes single values as batches of one")
+    {
+        subject.subscribeBatches(collectBatches);
+
+        subject.onNext(7);
+        subject.onNext(8);
+
+        ReaX_CheckValues(values, 7, 8);
+        ReaX_RequireValues(batchSizes, 1, 1);
+    }
+}
+
+TEST_CASE("TypedObservable interop",
+          "[TypedObservable]")
+{
+    Array<int> values;
+
+    IT("can be created from an Observable")
+    {
+        PublishSubject<int> subject;
+        TypedObservable<int> typed(subject);
+        ReaX_CollectValues(typed.map([](int i) { return i + 1; }), values);
+
+        subject.onNext(5);
+
+        ReaX_RequireValues(values, 6);
+    }
+
+    IT("can be converted to an Observable")
+    {
+        TypedPublishSubject<int> subject;
+        ReaX_CollectValues(subject.asObservable().map([](int i) { return i * 2; }), values);
+
+        subject.onNext(5);
+
+        ReaX_RequireValues(values, 10);
+    }
+
+    IT("unsubscribes from the TypedObservable when disposing the Observable's subscription")
+    {
+        TypedPublishSubject<int> subject;
+        auto subscription = subject.asObservable().subscribe([&](int i) { values.add(i); });
+
+        subject.onNext(1);
+        subscription.unsubscribe();
+        subject.onNext(2);
+
+        ReaX_RequireValues(values, 1);
+    }
+
+    IT("can push values to an Observer")
+    {
+        PublishSubject<int> subject;
+        ReaX_CollectValues(subject, values);
+        TypedObservable<int>::from({ 7, 8 }).subscribe(subject);
+
+        ReaX_RequireValues(values, 7, 8);
+    }
+
+    IT("can push values to a TypedObserver")
+    {
+        TypedPublishSubject<int> subject;
+        ReaX_CollectValues(subject, values);
+        TypedObservable<int>::from({ 7, 8 }).subscribe(subject);
+
+        ReaX_RequireValues(values, 7, 8);
+    }
+}
@@ -0,0 +1,92 @@
+#include "../Other/TestPrefix.h"
+#include "../Other/AllocationCounter.h"
+
+
+TEST_CASE("RealtimePipeline",
+          "[RealtimePipeline]")
+{
+    RealtimePipeline<float> pipeline;
+    Array<float> values;
+
+    IT("passes each value through map, filter and scan")
+    {
+        pipeline.input()
+            .map([](float value) { return value * 2; })
+            .filter([](float value) { return value > 2; })
+            .scan(0.f, [](float sum, float value) { return sum + value; })
+            .sink([&](float value) { values.add(value); });
+
+        const float block[] = { 1, 2, 3 };
+        pipeline.process(block, 3);
+
+        ReaX_RequireValues(values, 4.f, 10.f);
+    }
+
+    IT("emits the last value of each block with samplePerBlock")
+    {
+        pipeline.input().samplePerBlock().sink([&](float value) { values.add(value); });
+
+        const float firstBlock[] = { 1, 2, 3 };
+        pipeline.process(firstBlock, 3);
+        pipeline.process(nullptr, 0);
+        pipeline.process(4);
+
+        ReaX_RequireValues(values, 3.f, 4.f);
+    }
+
+    IT("suppresses duplicates across blocks with distinctUntilChanged")
+    {
+        pipeline.input().distinctUntilChanged().sink([&](float value) { values.add(value); });
+
+        pipeline.process(1);
+        pipeline.process(1);
+        pipeline.process(2);
+
+        ReaX_RequireValues(values, 1.f, 2.f);
+    }
+
+    IT("passes each value to all branches")
+    {
+        Array<int> rounded;
+        const auto input = pipeline.input();
+        input.sink([&](float value) { values.add(value); });
+        input.map([](float value) { return roundToInt(value); }).sink([&](int value) { rounded.add(value); });
+
+        const float block[] = { 1.2f, 2.7f };
+        pipeline.process(block, 2);
+
+        ReaX_RequireValues(values, 1.2f, 2.7f);
+        ReaX_RequireValues(rounded, 1, 3);
+    }
+
+    IT("doesn't allocate memory while processing")
+    {
+        // Counted without an Array, because adding to it may allocate
+        int numValues = 0;
+        float lastValue = 0;
+        pipeline.input()
+            .map([](float value) { return value * 2; })
+            .scan(0.f, [](float sum, float value) { return sum + value; })
+            .distinctUntilChanged()
+            .samplePerBlock()
+            .sink([&](float value) {
+                numValues++;
+                lastValue = value;
+            });
+
+        const float block[] = { 1, 0, 2, 0 };
+        pipeline.process(block, 4);
+        CHECK(numValues == 1);
+
+        AllocationCounter counter;
+
+        for (int i = 0; i < 100; i++) {
+            pipeline.process(block, 4);
+            pipeline.process(1.f);
+        }
+
+        REQUIRE(counter.getNumAllocations() == 0);
+        REQUIRE(numValues == 201);
+        REQUIRE(lastValue == 806.f);
+    }
+}
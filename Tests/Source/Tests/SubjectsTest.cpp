@@ -68,6 +68,18 @@ TEST_CASE("BehaviorSubject",
         subject.onCompleted();
         subject.onCompleted();
     }
+
+    IT("doesn't emit its value to subscribers after it has completed")
+    {
+        subject.onCompleted();
+
+        Array<var> laterValues;
+        bool completed = false;
+        subject.subscribe([&](var v) { laterValues.add(v); }, [](std::exception_ptr) {}, [&]() { completed = true; });
+
+        CHECK(laterValues.isEmpty());
+        REQUIRE(completed);
+    }
     
     IT("can receive an initial value of a custom type, without wrapping with toVar()")
     {
@@ -133,6 +145,77 @@ TEST_CASE("PublishSubject",
         ReaX_RequireValues(values, 12345);
     }
 
+    IT("emits on several threads while Observers subscribe and unsubscribe")
+    {
+        PublishSubject<int> subject;
+        std::atomic<int> numReceived(0);
+        std::atomic<bool> isEmitting(true);
+        subject.subscribe([&numReceived](int) { numReceived++; }).disposedBy(disposeBag);
+
+        std::thread churn([&]() {
+            while (isEmitting)
+                subject.subscribe([](int) {}).unsubscribe();
+        });
+
+        std::vector<std::thread> emitters;
+
+        for (int i = 0; i < 3; i++) {
+            emitters.emplace_back([&subject]() {
+                for (int j = 0; j < 10000; j++)
+                    subject.onNext(j);
+            });
+        }
+
+        for (auto& emitter : emitters)
+            emitter.join();
+
+        isEmitting = false;
+        churn.join();
+
+        REQUIRE(numReceived == 30000);
+    }
+
+    IT("keeps the list of Observers alive while emitting, when it's replaced twice in a row")
+    {
+        // Several threads replace the list back to back, so a reader may be preempted across two replacements. Each churning Observer reads its own state, so a released list (or Observer) is likely to crash here, or under a sanitizer.
+        PublishSubject<int> subject;
+        std::atomic<int> numReceived(0);
+        std::atomic<bool> isEmitting(true);
+        subject.subscribe([&numReceived](int) { numReceived++; }).disposedBy(disposeBag);
+
+        std::vector<std::thread> churns;
+
+        for (int i = 0; i < 3; i++) {
+            churns.emplace_back([&]() {
+                while (isEmitting) {
+                    const auto state = std::make_shared<int>(0);
+                    const Subscription subscription = subject.subscribe([state](int value) { *state += value; });
+                    subject.subscribe([state](int) {}).unsubscribe();
+                    subscription.unsubscribe();
+                }
+            });
+        }
+
+        std::vector<std::thread> emitters;
+
+        for (int i = 0; i < 4; i++) {
+            emitters.emplace_back([&subject]() {
+                for (int j = 0; j < 20000; j++)
+                    subject.onNext(j);
+            });
+        }
+
+        for (auto& emitter : emitters)
+            emitter.join();
+
+        isEmitting = false;
+
+        for (auto& churn : churns)
+            churn.join();
+
+        REQUIRE(numReceived == 80000);
+    }
+
     IT("emits an error when calling onError")
     {
         PublishSubject<int> subject;
@@ -210,6 +293,23 @@ TEST_CASE("ReplaySubject",
         ReaX_RequireValues(laterValues, 1, 2);
     }
 
+    IT("emits values pushed during the replay after the replayed values")
+    {
+        subject.onNext(1);
+        subject.onNext(2);
+
+        // The subscriber pushes a new value while the first value is replayed to it
+        Array<var> laterValues;
+        subject.subscribe([&](var v) {
+            laterValues.add(v);
+
+            if (v == var(1))
+                subject.onNext(3);
+        }).disposedBy(disposeBag);
+
+        ReaX_RequireValues(laterValues, 1, 2, 3);
+    }
+
     IT("emits previous values limited by the max. buffer size")
     {
         auto subject = std::make_shared<ReplaySubject<var>>(4);
@@ -230,6 +330,20 @@ TEST_CASE("ReplaySubject",
         ReaX_RequireValues(values, 7, 28, 3, 6);
     }
 
+    IT("emits previous values to subscribers after it has completed")
+    {
+        subject.onNext(1);
+        subject.onNext(2);
+        subject.onCompleted();
+
+        Array<var> laterValues;
+        bool completed = false;
+        subject.subscribe([&](var v) { laterValues.add(v); }, [](std::exception_ptr) {}, [&]() { completed = true; });
+
+        ReaX_CheckValues(laterValues, 1, 2);
+        REQUIRE(completed);
+    }
+
     IT("changes value when changing the Observer")
     {
         subject.onNext(32.51);
@@ -318,3 +432,48 @@ TEST_CASE("onNext move overload",
         REQUIRE(counters.numMoveAssignments == 0);
     }
 }
+
+TEST_CASE("Move-only values",
+          "[Subject][Observer]")
+{
+    PublishSubject<std::unique_ptr<int>> subject;
+    std::unique_ptr<int> value(new int(17));
+    int* const address = value.get();
+    
+    IT("emits a move-only value to all subscribers, without copying it")
+    {
+        Array<const int*> addresses;
+        subject.subscribe([&](const std::unique_ptr<int>& ptr) { addresses.add(ptr.get()); });
+        subject.subscribe([&](const std::unique_ptr<int>& ptr) { addresses.add(ptr.get()); });
+        
+        subject.onNext(std::move(value));
+        
+        ReaX_RequireValues(addresses, address, address);
+    }
+    
+    IT("can map to a move-only value")
+    {
+        Array<int> values;
+        ReaX_CollectValues(subject.map([](const std::unique_ptr<int>& ptr) { return std::unique_ptr<String>(new String(*ptr)); })
+                               .map([](const std::unique_ptr<String>& string) { return string->getIntValue() + 1; }),
+                           values);
+        
+        subject.onNext(std::move(value));
+        
+        ReaX_RequireValues(values, 18);
+    }
+    
+    IT("shares the value with asSharedPointers")
+    {
+        std::shared_ptr<const std::unique_ptr<int>> first;
+        std::shared_ptr<const std::unique_ptr<int>> second;
+        subject.asSharedPointers().subscribe([&](const std::shared_ptr<const std::unique_ptr<int>>& ptr) { first = ptr; });
+        subject.asSharedPointers().subscribe([&](const std::shared_ptr<const std::unique_ptr<int>>& ptr) { second = ptr; });
+        
+        subject.onNext(std::move(value));
+        
+        REQUIRE(first == second);
+        REQUIRE(first->get() == address);
+        REQUIRE(**first == 17);
+    }
+}
@@ -12,6 +12,7 @@ using namespace juce;
 #include "integration/reax_ModelExtensions.cpp"
 #include "integration/reax_ReactiveModel.cpp"
 
+#include "util/internal/reax_ObjectPool.cpp"
 #include "util/internal/reax_any.cpp"
 }
 
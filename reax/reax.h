@@ -18,6 +18,7 @@ END_JUCE_MODULE_DECLARATION
 
 #include "util/internal/concurrentqueue.h"
 
+#include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_core/juce_core.h>
 #include <juce_data_structures/juce_data_structures.h>
 #include <juce_events/juce_events.h>
@@ -25,6 +26,8 @@ END_JUCE_MODULE_DECLARATION
 #include <juce_gui_basics/juce_gui_basics.h>
 
 #include <atomic>
+#include <cstddef>
+#include <deque>
 #include <exception>
 #include <functional>
 #include <initializer_list>
@@ -46,19 +49,32 @@ namespace reax {
 /// Used for Observables that don't emit a meaningful value, and just notify that something has changed.
 typedef std::tuple<> Empty;
 
+#include "util/internal/reax_ObjectPool.h"
 #include "util/internal/reax_any.h"
 #include "rx/reax_Subscription.h"
 #include "rx/reax_DisposeBag.h"
+#include "rx/internal/reax_PushCore.h"
 #include "rx/internal/reax_Observer_Impl.h"
 #include "rx/reax_Observer.h"
 #include "rx/reax_Scheduler.h"
+#include "rx/internal/reax_Scheduler_Impl.h"
 #include "rx/internal/reax_Observable_Impl.h"
+#include "rx/internal/reax_Batcher.h"
+#include "rx/internal/reax_Combiners.h"
 #include "rx/reax_Observable.h"
+#include "rx/reax_ConnectableObservable.h"
 #include "rx/internal/reax_Subjects_Impl.h"
 #include "rx/reax_Subjects.h"
+#include "rx/internal/reax_MergeHub_Impl.h"
+#include "rx/reax_MergeHub.h"
+#include "rx/reax_TypedObservable.h"
+#include "rx/internal/reax_Simd_Impl.h"
+#include "rx/reax_SimdOperators.h"
 
 #include "util/reax_LockFreeSource.h"
 #include "util/reax_LockFreeTarget.h"
+#include "util/reax_RealtimePipeline.h"
+#include "util/reax_MemoryPool.h"
 
 #include "integration/reax_GUIExtensions.h"
 #include "integration/reax_ModelExtensions.h"
@@ -1,6 +1,18 @@
 #include <juce_core/juce_core.h>
 #include <juce_data_structures/juce_data_structures.h>
 
+// For setting the priority of the threads that ReaX creates
+#if JUCE_LINUX || JUCE_ANDROID
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif JUCE_MAC || JUCE_IOS
+#include <pthread.h>
+#include <pthread/qos.h>
+#endif
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wcomma"
 #include "RxCpp/Rx/v2/src/rxcpp/rx.hpp"
@@ -14,14 +26,18 @@ REAX_ENABLE_EXTRA_WARNINGS
 namespace reax {
 using namespace juce;
 
+#include "util/internal/reax_ObjectPool.h"
 #include "util/internal/reax_any.h"
     
 #include "rx/reax_Subscription.h"
+#include "rx/internal/reax_PushCore.h"
 #include "rx/internal/reax_Observable_Impl.h"
 #include "rx/reax_Scheduler.h"
 #include "rx/internal/reax_Observer_Impl.h"
 #include "rx/internal/reax_Scheduler_Impl.h"
+#include "rx/internal/reax_ThreadPool.h"
 #include "rx/internal/reax_Subjects_Impl.h"
+#include "rx/internal/reax_MergeHub_Impl.h"
 #include "rx/reax_DisposeBag.h"
 #include "rx/reax_Subscription.cpp"
 #include "rx/reax_DisposeBag.cpp"
@@ -30,6 +46,7 @@ using namespace juce;
 #include "rx/internal/reax_Observable_Impl.cpp"
 #include "rx/internal/reax_Observer_Impl.cpp"
 #include "rx/internal/reax_Subjects_Impl.cpp"
+#include "rx/internal/reax_MergeHub_Impl.cpp"
 }
 
 #pragma clang diagnostic pop
@@ -0,0 +1,210 @@
+#pragma once
+
+namespace detail {
+/**
+ Collects values into batches, and emits each batch as a juce::Array. Used by Observable::bufferWithCount, Observable::bufferWithTime, Observable::bufferWithTimeOrCount and Observable::window.
+
+ A batch is emitted when it has `count` values (if `count` > 0, on the thread that has emitted the last value), every `interval` on the message thread (if `interval` > 0), and whenever flush is called. After a batch of `count` values is emitted, the first `skip` values are removed from it. So the next batch overlaps with it if `skip` < `count`, and values are dropped if `skip` > `count`.
+
+ The batch storage is reused: The Array is moved into the emitted value, and moved back after the observer has processed it.
+
+ The observer is called without holding the lock, so it may block on another thread (e.g. wait for the message thread). Only one thread emits at a time: Values and terminations that arrive while a batch is emitted are queued, and handled by the emitting thread afterwards.
+ */
+///@cond INTERNAL
+template<typename T>
+class Batcher : public juce::ReferenceCountedObject, private juce::Timer
+{
+public:
+    typedef juce::ReferenceCountedObjectPtr<Batcher> Ptr;
+
+    Batcher(const ObserverImpl& observer, unsigned int count, unsigned int skip, const juce::RelativeTime& interval)
+    : observer(observer),
+      count(static_cast<int>(count)),
+      skip(static_cast<int>(skip))
+    {
+        batch.ensureStorageAllocated(juce::jmax(this->count, 16));
+
+        if (interval.inMilliseconds() > 0)
+            startTimer(juce::jmax(1, static_cast<int>(interval.inMilliseconds())));
+    }
+
+    void onNext(const T& value)
+    {
+        const juce::ScopedLock lock(criticalSection);
+
+        if (terminated)
+            return;
+
+        // If a batch is being emitted (by this thread or another one), the value is added afterwards by the emitting thread
+        if (isEmitting) {
+            pendingValues.push_back(value);
+            return;
+        }
+
+        add(value);
+        addPendingValues();
+    }
+
+    void onError(std::exception_ptr error)
+    {
+        const juce::ScopedLock lock(criticalSection);
+
+        if (terminated)
+            return;
+
+        if (isEmitting) {
+            pendingTermination = Termination::Error;
+            pendingError = error;
+            return;
+        }
+
+        terminate(error);
+    }
+
+    void onCompleted()
+    {
+        const juce::ScopedLock lock(criticalSection);
+
+        if (terminated)
+            return;
+
+        if (isEmitting) {
+            pendingTermination = Termination::Completed;
+            return;
+        }
+
+        complete();
+    }
+
+    // Emits the current batch, unless it's empty. Called by the timer, or by the ticks of a Scheduler.
+    void flush()
+    {
+        const juce::ScopedLock lock(criticalSection);
+
+        if (terminated || isEmitting || batch.isEmpty())
+            return;
+
+        emit();
+        batch.clearQuick();
+        addPendingValues();
+    }
+
+    // Stops the timer. Must be called when the subscription ends.
+    void stop()
+    {
+        if (!isTimerRunning())
+            return;
+
+        if (juce::MessageManager::getInstance()->isThisTheMessageThread()) {
+            stopTimer();
+        }
+        else {
+            // Stop it on the message thread, so it doesn't get destroyed while the timer callback is running
+            const Ptr self(this);
+            juce::MessageManager::callAsync([self]() { self->stopTimer(); });
+        }
+    }
+
+private:
+    enum class Termination {
+        None,
+        Completed,
+        Error
+    };
+
+    const ObserverImpl observer;
+    const int count;
+    const int skip;
+    juce::CriticalSection criticalSection;
+    juce::Array<T> batch;
+    std::deque<T> pendingValues;
+    Termination pendingTermination = Termination::None;
+    std::exception_ptr pendingError;
+    int numToSkip = 0;
+    bool isEmitting = false;
+    bool terminated = false;
+
+    void timerCallback() override
+    {
+        flush();
+    }
+
+    void add(const T& value)
+    {
+        if (numToSkip > 0) {
+            numToSkip--;
+            return;
+        }
+
+        batch.add(value);
+
+        if (count > 0 && batch.size() == count) {
+            emit();
+
+            if (skip < count) {
+                batch.removeRange(0, skip);
+            }
+            else {
+                batch.clearQuick();
+                numToSkip = skip - count;
+            }
+        }
+    }
+
+    // Adds the values (and the termination) that have arrived while a batch was emitted
+    void addPendingValues()
+    {
+        while (!pendingValues.empty() && !terminated) {
+            const T value(std::move(pendingValues.front()));
+            pendingValues.pop_front();
+            add(value);
+        }
+
+        if (pendingTermination == Termination::None || terminated)
+            return;
+
+        if (pendingTermination == Termination::Error)
+            terminate(pendingError);
+        else
+            complete();
+    }
+
+    void complete()
+    {
+        // Emit the remaining values, unless they have already been emitted as part of an overlapping batch
+        if (!batch.isEmpty() && skip >= count) {
+            emit();
+            batch.clearQuick();
+        }
+
+        terminated = true;
+        const juce::ScopedUnlock unlock(criticalSection);
+        observer.onCompleted();
+    }
+
+    void terminate(std::exception_ptr error)
+    {
+        terminated = true;
+        const juce::ScopedUnlock unlock(criticalSection);
+        observer.onError(error);
+    }
+
+    // Emits the batch without holding the lock, and takes back its storage afterwards. The caller must hold the lock exactly once.
+    void emit()
+    {
+        isEmitting = true;
+        any emitted(std::move(batch));
+
+        {
+            const juce::ScopedUnlock unlock(criticalSection);
+            observer.onNext(emitted);
+        }
+
+        batch = emitted.take<juce::Array<T>>();
+        isEmitting = false;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Batcher)
+};
+///@endcond
+}
@@ -0,0 +1,252 @@
+#pragma once
+
+namespace detail {
+/**
+ Combines the values from any number of Observables into a juce::Array with one slot per Observable. Used by the Observable::combineLatest and Observable::zip overloads that take an Array of Observables.
+
+ With Kind::CombineLatest, a new value only replaces its slot, so each change costs O(1) (instead of rebuilding a tuple of all values). It starts emitting when every Observable has emitted a value, and completes when all of them have completed (or when one of them completes without having emitted a value).
+
+ With Kind::Zip, values are queued per Observable. It emits whenever each queue has a value, and completes when an Observable has completed and its queue is empty.
+
+ The Array storage is reused: The Array is moved into the emitted value, and moved back after the observer has processed it.
+
+ The observer is called without holding the lock, so it may block on another thread (e.g. wait for the message thread). Only one thread emits at a time: Values and terminations that arrive while the values are emitted are queued, and handled by the emitting thread afterwards.
+ */
+///@cond INTERNAL
+template<typename T>
+class Combiner : public juce::ReferenceCountedObject
+{
+public:
+    typedef juce::ReferenceCountedObjectPtr<Combiner> Ptr;
+
+    enum class Kind {
+        CombineLatest,
+        Zip
+    };
+
+    Combiner(const ObserverImpl& observer, Kind kind, int numSources)
+    : observer(observer),
+      kind(kind),
+      numSources(numSources),
+      numActive(numSources),
+      hasValue(static_cast<size_t>(numSources), false),
+      isCompleted(static_cast<size_t>(numSources), false)
+    {
+        if (kind == Kind::CombineLatest)
+            firstValues.resize(static_cast<size_t>(numSources));
+        else
+            queues.resize(static_cast<size_t>(numSources));
+
+        values.ensureStorageAllocated(numSources);
+    }
+
+    void onNext(int index, const any& value)
+    {
+        const juce::ScopedLock lock(criticalSection);
+
+        if (terminated)
+            return;
+
+        if (kind == Kind::CombineLatest)
+            combineLatest(static_cast<size_t>(index), value);
+        else
+            zip(static_cast<size_t>(index), value);
+
+        if (!isEmitting)
+            terminatePending();
+    }
+
+    void onError(std::exception_ptr error)
+    {
+        const juce::ScopedLock lock(criticalSection);
+
+        if (terminated)
+            return;
+
+        if (isEmitting) {
+            if (pendingTermination == Termination::None) {
+                pendingTermination = Termination::Error;
+                pendingError = error;
+            }
+
+            return;
+        }
+
+        terminate(error);
+    }
+
+    void onCompleted(int index)
+    {
+        const juce::ScopedLock lock(criticalSection);
+
+        if (terminated)
+            return;
+
+        const size_t i = static_cast<size_t>(index);
+        isCompleted[i] = true;
+        numActive--;
+
+        // combineLatest can't emit anymore if an Observable completes without a value. zip can't emit anymore when a completed Observable has no queued values.
+        const bool canEmitMore = (kind == Kind::CombineLatest ? hasValue[i] && numActive > 0 : !queues[i].empty());
+
+        if (canEmitMore)
+            return;
+
+        if (isEmitting) {
+            if (pendingTermination == Termination::None)
+                pendingTermination = Termination::Completed;
+        }
+        else {
+            complete();
+        }
+    }
+
+    bool isTerminated() const
+    {
+        const juce::ScopedLock lock(criticalSection);
+        return terminated;
+    }
+
+private:
+    enum class Termination {
+        None,
+        Completed,
+        Error
+    };
+
+    const ObserverImpl observer;
+    const Kind kind;
+    const int numSources;
+    int numActive;
+    int numWithValues = 0;
+    std::vector<bool> hasValue;
+    std::vector<bool> isCompleted;
+    std::vector<std::unique_ptr<T>> firstValues;
+    std::deque<std::pair<size_t, any>> pendingUpdates;
+    std::vector<std::deque<T>> queues;
+    juce::Array<T> values;
+    juce::CriticalSection criticalSection;
+    Termination pendingTermination = Termination::None;
+    std::exception_ptr pendingError;
+    bool isEmitting = false;
+    bool terminated = false;
+
+    void combineLatest(size_t index, const any& value)
+    {
+        if (numWithValues == numSources) {
+            // If the values are being emitted (by this thread or another one), the slot is updated afterwards by the emitting thread
+            pendingUpdates.emplace_back(index, value);
+
+            if (!isEmitting)
+                emitPendingUpdates();
+
+            return;
+        }
+
+        // Keep the first values until each Observable has emitted one, because T may not be default-constructible
+        firstValues[index].reset(new T(value.get<T>()));
+
+        if (!hasValue[index]) {
+            hasValue[index] = true;
+            numWithValues++;
+        }
+
+        if (numWithValues == numSources) {
+            for (auto& firstValue : firstValues)
+                values.add(std::move(*firstValue));
+
+            firstValues.clear();
+            emit();
+            emitPendingUpdates();
+        }
+    }
+
+    void emitPendingUpdates()
+    {
+        while (!pendingUpdates.empty() && !terminated) {
+            const std::pair<size_t, any> update(std::move(pendingUpdates.front()));
+            pendingUpdates.pop_front();
+
+            values.getReference(static_cast<int>(update.first)) = update.second.get<T>();
+            emit();
+        }
+    }
+
+    void zip(size_t index, const any& value)
+    {
+        std::deque<T>& queue = queues[index];
+        queue.push_back(value.get<T>());
+
+        if (queue.size() == 1)
+            numWithValues++;
+
+        // If the values are being emitted (by this thread or another one), the queued values are zipped afterwards by the emitting thread
+        if (isEmitting)
+            return;
+
+        while (numWithValues == numSources && !terminated) {
+            values.clearQuick();
+            bool isExhausted = false;
+
+            for (size_t i = 0; i < queues.size(); i++) {
+                values.add(std::move(queues[i].front()));
+                queues[i].pop_front();
+
+                if (queues[i].empty()) {
+                    numWithValues--;
+                    isExhausted = (isExhausted || isCompleted[i]);
+                }
+            }
+
+            emit();
+
+            if (isExhausted && !terminated)
+                complete();
+        }
+    }
+
+    // Handles a termination that has arrived while the values were emitted
+    void terminatePending()
+    {
+        if (pendingTermination == Termination::None || terminated)
+            return;
+
+        if (pendingTermination == Termination::Error)
+            terminate(pendingError);
+        else
+            complete();
+    }
+
+    void complete()
+    {
+        terminated = true;
+        const juce::ScopedUnlock unlock(criticalSection);
+        observer.onCompleted();
+    }
+
+    void terminate(std::exception_ptr error)
+    {
+        terminated = true;
+        const juce::ScopedUnlock unlock(criticalSection);
+        observer.onError(error);
+    }
+
+    // Emits the values without holding the lock, and takes back their storage afterwards. The caller must hold the lock exactly once.
+    void emit()
+    {
+        isEmitting = true;
+        any emitted(std::move(values));
+
+        {
+            const juce::ScopedUnlock unlock(criticalSection);
+            observer.onNext(emitted);
+        }
+
+        values = emitted.take<juce::Array<T>>();
+        isEmitting = false;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Combiner)
+};
+///@endcond
+}
@@ -0,0 +1,30 @@
+namespace detail {
+MergeHubImpl::MergeHubImpl()
+: wrapped(PushMergeHub<any>::Ptr(new PushMergeHub<any>()))
+{}
+
+MergeHubImpl::Handle MergeHubImpl::add(const ObservableImpl& source) const
+{
+    return wrapped.get<PushMergeHub<any>::Ptr>()->add(toPushSource(source.wrapped));
+}
+
+void MergeHubImpl::remove(Handle handle) const
+{
+    wrapped.get<PushMergeHub<any>::Ptr>()->remove(handle);
+}
+
+size_t MergeHubImpl::getNumSources() const
+{
+    return wrapped.get<PushMergeHub<any>::Ptr>()->getNumSources();
+}
+
+void MergeHubImpl::complete() const
+{
+    wrapped.get<PushMergeHub<any>::Ptr>()->terminate(false, std::exception_ptr());
+}
+
+ObservableImpl MergeHubImpl::asObservable() const
+{
+    return ObservableImpl(wrap(wrapped.get<PushMergeHub<any>::Ptr>()->getSource()));
+}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+namespace detail {
+struct MergeHubImpl
+{
+    typedef PushMergeHub<any>::Handle Handle;
+
+    MergeHubImpl();
+
+    Handle add(const ObservableImpl& source) const;
+    void remove(Handle handle) const;
+    size_t getNumSources() const;
+    void complete() const;
+
+    ObservableImpl asObservable() const;
+
+    const any wrapped;
+};
+}
@@ -7,38 +7,83 @@ std::chrono::milliseconds durationFromRelativeTime(const juce::RelativeTime& rel
 const std::runtime_error InvalidRangeError("Invalid range.");
 using detail::any;
 
+typedef detail::PushSource<any>::Ptr PushSourcePtr;
+typedef detail::PushObserver<any>::Ptr PushObserverPtr;
+typedef detail::PushSubscription::Ptr PushSubscriptionPtr;
+typedef detail::PushObserverHandle<any> PushHandle;
+typedef detail::PushConnectable<any>::Ptr PushConnectablePtr;
+
 // An Observable that holds a Value to keep receiving changes until the Observable is destroyed.
 class ValueObservable : private Value::Listener
 {
 public:
     ValueObservable(const Value& inputValue)
     : value(inputValue),
-      subject(inputValue)
+      subject(new detail::PushSubject<any>(1, false))
     {
+        subject->onNext(any(inputValue.getValue()));
         value.addListener(this);
     }
 
     ~ValueObservable()
     {
         value.removeListener(this);
-        subject.get_subscriber().on_completed();
+        subject->onCompleted();
     }
 
     void valueChanged(Value& newValue) override
     {
-        subject.get_subscriber().on_next(newValue);
+        subject->onNext(any(newValue.getValue()));
     }
 
-    rxcpp::observable<var> getObservable() const
+    // The returned source doesn't keep this ValueObservable alive
+    PushSourcePtr getSource() const
     {
-        return subject.get_observable();
+        return subject.get();
     }
 
 private:
     Value value;
-    const rxcpp::subjects::behavior<var> subject;
+    const detail::PushSubject<any>::Ptr subject;
 };
 
+// A block of adjacent stateless stages (map, filter, takeWhile), which are collected when the Observable is constructed.
+// The block runs in a single node (in rxcpp or in the push core), so each value passes through one observer instead of one per operator.
+// Each FusedStages holds the last stage, and shares the stages before it with the Observable that it was created from. So appending a stage doesn't copy the previous ones. They are collected into a flat list once per subscription (see flattenStages).
+struct FusedStages
+{
+    enum class Kind {
+        Map,
+        Filter,
+        TakeWhile
+    };
+
+    struct Stage
+    {
+        Kind kind;
+        std::function<any(const any&)> function;
+        std::function<bool(const any&)> predicate;
+    };
+
+    FusedStages(const any& source, const std::shared_ptr<const FusedStages>& previous, const Stage& stage)
+    : source(source),
+      previous(previous),
+      stage(stage),
+      numStages(previous != nullptr ? previous->numStages + 1 : 1)
+    {}
+
+    // The wrapped Observable that the first stage subscribes to
+    const any source;
+
+    // The stages before this one, or nullptr if this is the first stage
+    const std::shared_ptr<const FusedStages> previous;
+    const Stage stage;
+    const size_t numStages;
+};
+
+typedef std::shared_ptr<const FusedStages> FusedStagesPtr;
+typedef std::shared_ptr<const std::vector<FusedStages::Stage>> FlatStagesPtr;
+
 using Function2 = std::function<any(const any&, const any&)>;
 using Function3 = std::function<any(const any&, const any&, const any&)>;
 using Function4 = std::function<any(const any&, const any&, const any&, const any&)>;
@@ -53,12 +98,214 @@ inline any wrap(const rxcpp::observable<any>& observable)
     return any(observable);
 }
 
-inline rxcpp::observable<any> unwrap(const any& wrapped)
+inline any wrap(const PushSourcePtr& source)
+{
+    return any(source);
+}
+
+// Whether the wrapped Observable runs in the push core. Operators on these Observables stay in the push core, if they are implemented there.
+bool isNative(const any& wrapped)
+{
+    if (wrapped.is<FusedStagesPtr>())
+        return isNative(wrapped.get<FusedStagesPtr>()->source);
+
+    return (wrapped.is<PushSourcePtr>() || wrapped.is<PushConnectablePtr>() || wrapped.is<std::shared_ptr<ValueObservable>>());
+}
+
+// Returns the stages of a block, from the first to the last
+FlatStagesPtr flattenStages(const FusedStages& fused)
+{
+    const auto stages = std::make_shared<std::vector<FusedStages::Stage>>(fused.numStages);
+    const FusedStages* current = &fused;
+
+    for (size_t i = fused.numStages; i > 0; --i, current = current->previous.get())
+        (*stages)[i - 1] = current->stage;
+
+    return stages;
+}
+
+// Runs a value through the fused stages, starting at the given index, and calls emit with the result.
+// Like in rxcpp, exceptions from stage functions are passed to fail, but exceptions from emit are not caught.
+template<typename Emit, typename Fail, typename Complete>
+void runFusedStages(const std::vector<FusedStages::Stage>& stages, size_t index, const any& value, const Emit& emit, const Fail& fail, const Complete& complete)
+{
+    for (; index < stages.size(); ++index) {
+        const FusedStages::Stage& stage = stages[index];
+        detail::PushResult<any> mapped;
+        bool passes = true;
+
+        try {
+            if (stage.kind == FusedStages::Kind::Map)
+                mapped.emplace(stage.function, value);
+            else
+                passes = stage.predicate(value);
+        }
+        catch (...) {
+            fail(std::current_exception());
+            return;
+        }
+
+        // Continue with the mapped value. This only recurses once per map stage.
+        if (stage.kind == FusedStages::Kind::Map)
+            return runFusedStages(stages, index + 1, mapped.get(), emit, fail, complete);
+
+        if (!passes) {
+            if (stage.kind == FusedStages::Kind::TakeWhile)
+                complete();
+
+            return;
+        }
+    }
+
+    emit(value);
+}
+
+// Runs a block of fused stages in the push core
+class FusedStagesObserver : public detail::PushForwardingObserver<any>
+{
+public:
+    FusedStagesObserver(const PushObserverPtr& downstream, const PushSubscriptionPtr& subscription, const FlatStagesPtr& stages)
+    : PushForwardingObserver<any>(downstream, subscription),
+      stages(stages)
+    {}
+
+    void onNext(const any& value) override
+    {
+        // A batch may have ended the subscription (if a takeWhile stage stopped)
+        if (hasEnded())
+            return;
+
+        runFusedStages(*stages, 0, value, [this](const any& result) { downstream->onNext(result); }, [this](std::exception_ptr error) { downstream->onError(error); }, [this]() {
+            downstream->onCompleted();
+            subscription->unsubscribe();
+        });
+    }
+
+    // Stops at the value that ended the subscription
+    void onNextBatch(const any* values, size_t numValues) override
+    {
+        for (size_t i = 0; i < numValues && !hasEnded(); i++)
+            onNext(values[i]);
+    }
+
+private:
+    const FlatStagesPtr stages;
+};
+
+// Emits the values from a push core source to an rxcpp subscriber
+class RxcppSubscriberObserver : public detail::PushObserver<any>
+{
+public:
+    explicit RxcppSubscriberObserver(const rxcpp::subscriber<any>& subscriber)
+    : subscriber(subscriber)
+    {}
+
+    void onNext(const any& value) override
+    {
+        subscriber.on_next(value);
+    }
+
+    void onError(std::exception_ptr error) override
+    {
+        subscriber.on_error(error);
+    }
+
+    void onCompleted() override
+    {
+        subscriber.on_completed();
+    }
+
+private:
+    const rxcpp::subscriber<any> subscriber;
+};
+
+rxcpp::observable<any> unwrap(const any& wrapped);
+
+// Returns the wrapped Observable as a push core source. rxcpp observables are subscribed to on each subscription.
+PushSourcePtr toPushSource(const any& wrapped)
+{
+    if (wrapped.is<PushSourcePtr>())
+        return wrapped.get<PushSourcePtr>();
+
+    if (wrapped.is<PushConnectablePtr>())
+        return wrapped.get<PushConnectablePtr>().get();
+
+    if (wrapped.is<std::shared_ptr<ValueObservable>>())
+        return wrapped.get<std::shared_ptr<ValueObservable>>()->getSource();
+
+    if (wrapped.is<FusedStagesPtr>()) {
+        const FusedStagesPtr& fused = wrapped.get<FusedStagesPtr>();
+        const FlatStagesPtr stages = flattenStages(*fused);
+
+        return detail::pushLift<any, any>(toPushSource(fused->source), [stages](const PushObserverPtr& downstream, const PushSubscriptionPtr& subscription) {
+            return PushObserverPtr(new FusedStagesObserver(downstream, subscription, stages));
+        });
+    }
+
+    const rxcpp::observable<any> observable = unwrap(wrapped);
+
+    return new detail::PushCreateSource<any>([observable](const PushObserverPtr& observer, const PushSubscriptionPtr& subscription) {
+        rxcpp::composite_subscription lifetime;
+        subscription->add([lifetime]() { lifetime.unsubscribe(); });
+
+        observable.subscribe(lifetime,
+                             [observer](const any& value) { observer->onNext(value); },
+                             [observer](std::exception_ptr error) { observer->onError(error); },
+                             [observer]() { observer->onCompleted(); });
+    });
+}
+
+// Returns the wrapped Observable as an rxcpp observable. Push core sources are subscribed to on each subscription.
+rxcpp::observable<any> unwrap(const any& wrapped)
 {
     if (wrapped.is<rxcpp::observable<any>>())
         return wrapped.get<rxcpp::observable<any>>();
-    else
-        return wrapped.get<std::shared_ptr<ValueObservable>>()->getObservable().map([](const var& value) { return any(value); });
+
+    if (wrapped.is<FusedStagesPtr>() && !isNative(wrapped)) {
+        const FusedStagesPtr& fused = wrapped.get<FusedStagesPtr>();
+        const rxcpp::observable<any> source = unwrap(fused->source);
+        const FlatStagesPtr stages = flattenStages(*fused);
+
+        return rxcpp::observable<>::create<any>([source, stages](const rxcpp::subscriber<any>& subscriber) {
+            // Share the subscriber's lifetime, so that unsubscribing (or completing in takeWhile) also unsubscribes from the source
+            source.subscribe(subscriber.get_subscription(),
+                             [stages, subscriber](const any& value) {
+                                 runFusedStages(*stages, 0, value, [&subscriber](const any& result) { subscriber.on_next(result); }, [&subscriber](std::exception_ptr error) { subscriber.on_error(error); }, [&subscriber]() { subscriber.on_completed(); });
+                             },
+                             [subscriber](std::exception_ptr error) { subscriber.on_error(error); },
+                             [subscriber]() { subscriber.on_completed(); });
+        });
+    }
+
+    const PushSourcePtr source = toPushSource(wrapped);
+
+    return rxcpp::observable<>::create<any>([source](const rxcpp::subscriber<any>& subscriber) {
+        const PushSubscriptionPtr subscription(new detail::PushSubscription());
+        subscriber.add([subscription]() { subscription->unsubscribe(); });
+        source->subscribe(new RxcppSubscriberObserver(subscriber), subscription);
+    });
+}
+
+// Appends a stage to the block of fused stages at the end of the wrapped Observable, or starts a new block. The new block shares the previous stages, so this is O(1).
+any fuse(const any& wrapped, FusedStages::Kind kind, const std::function<any(const any&)>& function, const std::function<bool(const any&)>& predicate)
+{
+    const FusedStages::Stage stage{ kind, function, predicate };
+
+    if (wrapped.is<FusedStagesPtr>()) {
+        const FusedStagesPtr& previous = wrapped.get<FusedStagesPtr>();
+        return any(FusedStagesPtr(std::make_shared<FusedStages>(previous->source, previous, stage)));
+    }
+
+    // Don't keep a ValueObservable alive: The block must stop emitting when the Observable returned by fromValue is destroyed.
+    const any source = (wrapped.is<std::shared_ptr<ValueObservable>>() ? wrap(toPushSource(wrapped)) : wrapped);
+
+    return any(FusedStagesPtr(std::make_shared<FusedStages>(source, nullptr, stage)));
+}
+
+// Wraps a push core source for an operator that's implemented in the push core
+any wrapNative(const any& wrapped, const std::function<PushSourcePtr(const PushSourcePtr&)>& makeSource)
+{
+    return wrap(makeSource(toPushSource(wrapped)));
 }
 
 template<typename T>
@@ -78,16 +325,17 @@ rxcpp::observable<any> _combineLatest(const any& wrapped, Function&& function, O
     return unwrap(wrapped).combine_latest(function, unwrap(observables.wrapped)...);
 }
 
-template<typename... Os>
-rxcpp::observable<any> _concat(const any& wrapped, Os&&... observables)
+// The push sources for an Observable and the given others, for operators that combine any number of Observables
+std::vector<PushSourcePtr> toPushSources(const any& wrapped, const Array<ObservableImpl>& others)
 {
-    return unwrap(wrapped).concat(unwrap(observables.wrapped)...);
-}
+    std::vector<PushSourcePtr> sources;
+    sources.reserve(static_cast<size_t>(others.size()) + 1);
+    sources.push_back(toPushSource(wrapped));
 
-template<typename... Os>
-rxcpp::observable<any> _merge(const any& wrapped, Os&&... observables)
-{
-    return unwrap(wrapped).merge(unwrap(observables.wrapped)...);
+    for (auto& other : others)
+        sources.push_back(toPushSource(other.wrapped));
+
+    return sources;
 }
 
 template<typename... Values>
@@ -119,16 +367,16 @@ ObservableImpl::ObservableImpl(const any& wrapped)
 
 ObservableImpl ObservableImpl::create(const std::function<void(ObserverImpl&&)>& onSubscribe)
 {
-    return wrap(rxcpp::observable<>::create<any>([onSubscribe](const rxcpp::subscriber<any>& s) {
-        onSubscribe(ObserverImpl(any(s)));
-    }));
+    return wrap(PushSourcePtr(new detail::PushCreateSource<any>([onSubscribe](const PushObserverPtr& observer, const PushSubscriptionPtr& subscription) {
+        onSubscribe(ObserverImpl(any(PushHandle{ observer, subscription })));
+    })));
 }
 
 ObservableImpl ObservableImpl::defer(const std::function<ObservableImpl()>& factory)
 {
-    return wrap(rxcpp::observable<>::defer([factory]() {
-        return factory().wrapped.get<rxcpp::observable<any>>();
-    }));
+    return wrap(PushSourcePtr(new detail::PushCreateSource<any>([factory](const PushObserverPtr& observer, const PushSubscriptionPtr& subscription) {
+        toPushSource(factory().wrapped)->subscribe(observer, subscription);
+    })));
 }
 
 ObservableImpl ObservableImpl::empty()
@@ -138,12 +386,12 @@ ObservableImpl ObservableImpl::empty()
 
 ObservableImpl ObservableImpl::error(const std::exception& error)
 {
-    return wrap(rxcpp::observable<>::error<any>(error));
+    return wrap(PushSourcePtr(new detail::PushTerminalSource<any>(detail::PushTerminalSource<any>::Kind::Error, std::make_exception_ptr(error))));
 }
 
 ObservableImpl ObservableImpl::from(Array<any>&& values)
 {
-    return wrap(rxcpp::observable<>::iterate(std::move(values), rxcpp::identity_immediate()));
+    return wrap(PushSourcePtr(new detail::PushFromSource<any>(std::move(values))));
 }
 
 ObservableImpl ObservableImpl::fromValue(Value value)
@@ -157,14 +405,22 @@ ObservableImpl ObservableImpl::interval(const juce::RelativeTime& period)
     return wrap(o.map([](long long value) { return any(value); }));
 }
 
+ObservableImpl ObservableImpl::interval(const juce::RelativeTime& period, const SchedulerImpl& scheduler)
+{
+    return wrap(PushSourcePtr(new detail::PushIntervalSource<any>(period, scheduler.createWorker)));
+}
+
 ObservableImpl ObservableImpl::just(const any& value)
 {
-    return wrap(rxcpp::observable<>::just(value));
+    Array<any> values;
+    values.add(value);
+
+    return from(std::move(values));
 }
 
 ObservableImpl ObservableImpl::never()
 {
-    return wrap(rxcpp::observable<>::never<any>());
+    return wrap(PushSourcePtr(new detail::PushTerminalSource<any>(detail::PushTerminalSource<any>::Kind::Never)));
 }
 
 ObservableImpl ObservableImpl::integralRange(long long first, long long last, unsigned int step)
@@ -199,6 +455,9 @@ Subscription ObservableImpl::subscribe(const std::function<void(const any&)>& on
                                        const std::function<void(std::exception_ptr)>& onError,
                                        const std::function<void()>& onCompleted) const
 {
+    if (isNative(wrapped))
+        return Subscription(any(detail::pushSubscribe<any>(toPushSource(wrapped), onNext, onError, onCompleted)));
+
     rxcpp::subscription subscription = unwrap(wrapped).subscribe(onNext, onError, onCompleted);
 
     return Subscription(any(subscription));
@@ -206,12 +465,24 @@ Subscription ObservableImpl::subscribe(const std::function<void(const any&)>& on
 
 Subscription ObservableImpl::subscribe(const ObserverImpl& observer) const
 {
-    auto subscriber = observer.wrapped.get<rxcpp::subscriber<any>>();
-    rxcpp::subscription subscription = unwrap(wrapped).subscribe(subscriber);
+    const PushHandle& handle = observer.wrapped.get<PushHandle>();
+
+    // Like when subscribing an rxcpp subscriber, use the Observer's subscription if it has one (e.g. in Observable::create)
+    const PushSubscriptionPtr subscription = (handle.subscription != nullptr ? handle.subscription : PushSubscriptionPtr(new detail::PushSubscription()));
+    toPushSource(wrapped)->subscribe(handle.observer, subscription);
 
     return Subscription(any(subscription));
 }
 
+Subscription ObservableImpl::subscribeWithDemand(unsigned int initialDemand,
+                                                 const std::function<void(const any&)>& onNext,
+                                                 const std::function<void(std::exception_ptr)>& onError,
+                                                 const std::function<void()>& onCompleted) const
+{
+    // rxcpp Observables are wrapped, too. They don't support flow control, so they emit all values regardless of the demand.
+    return Subscription(any(detail::pushSubscribeWithDemand<any>(toPushSource(wrapped), initialDemand, onNext, onError, onCompleted)));
+}
+
 
 #pragma mark - Operators
 
@@ -270,7 +541,7 @@ ObservableImpl ObservableImpl::combineLatest(std::initializer_list<ObservableImp
 
 ObservableImpl ObservableImpl::concat(const Array<ObservableImpl>& others) const
 {
-    REAX_OBSERVABLE_IMPL_UNROLLED_LIST_IMPLEMENTATION(concat, others);
+    return wrap(PushSourcePtr(new detail::PushConcatSource<any>(toPushSources(wrapped, others))));
 }
 
 ObservableImpl ObservableImpl::debounce(const juce::RelativeTime& period) const
@@ -278,8 +549,16 @@ ObservableImpl ObservableImpl::debounce(const juce::RelativeTime& period) const
     return wrap(unwrap(wrapped).debounce(durationFromRelativeTime(period)));
 }
 
+ObservableImpl ObservableImpl::debounce(const juce::RelativeTime& period, const SchedulerImpl& scheduler) const
+{
+    return wrap(PushSourcePtr(new detail::PushDebounceSource<any>(toPushSource(wrapped), period, scheduler.createWorker)));
+}
+
 ObservableImpl ObservableImpl::distinctUntilChanged(const std::function<bool(const any&, const any&)>& equals) const
 {
+    if (isNative(wrapped))
+        return wrapNative(wrapped, [equals](const PushSourcePtr& source) { return detail::pushDistinctUntilChanged<any>(source, equals); });
+
     return wrap(unwrap(wrapped).distinct_until_changed(equals));
 }
 
@@ -290,28 +569,31 @@ ObservableImpl ObservableImpl::elementAt(int index) const
 
 ObservableImpl ObservableImpl::filter(const std::function<bool(const any&)>& predicate) const
 {
-    // On Visual Studio, the predicate must be wrapped in a lambda, otherwise RxCpp fails to compile
-    return wrap(unwrap(wrapped).filter([predicate](const any& value) { return predicate(value); }));
+    return ObservableImpl(fuse(wrapped, FusedStages::Kind::Filter, nullptr, predicate));
 }
 
-ObservableImpl ObservableImpl::flatMap(const std::function<ObservableImpl(const any&)>& f) const
+ObservableImpl ObservableImpl::flatMap(const std::function<ObservableImpl(const any&)>& f, unsigned int maxConcurrent, unsigned int prefetch) const
 {
-    return wrap(unwrap(wrapped).flat_map([f](const any& value) {
-        return unwrap(f(value).wrapped);
-    }));
+    return wrap(PushSourcePtr(new detail::PushFlatMapSource<any, any>(toPushSource(wrapped), [f](const any& value) {
+        return toPushSource(f(value).wrapped);
+    }, maxConcurrent, prefetch)));
 }
 
 ObservableImpl ObservableImpl::map(const std::function<any(const any&)>& function) const
 {
-    return wrap(unwrap(wrapped).map(function));
+    return ObservableImpl(fuse(wrapped, FusedStages::Kind::Map, function, nullptr));
 }
 
-ObservableImpl ObservableImpl::merge(const juce::Array<ObservableImpl>& others) const {
-    REAX_OBSERVABLE_IMPL_UNROLLED_LIST_IMPLEMENTATION(merge, others)
+ObservableImpl ObservableImpl::merge(const juce::Array<ObservableImpl>& others) const
+{
+    return wrap(PushSourcePtr(new detail::PushMergeSource<any>(toPushSources(wrapped, others))));
 }
 
 ObservableImpl ObservableImpl::reduce(const any& startValue, const std::function<any(const any&, const any&)>& f) const
 {
+    if (isNative(wrapped))
+        return wrapNative(wrapped, [startValue, f](const PushSourcePtr& source) { return detail::pushScan<any>(source, startValue, f, false); });
+
     return wrap(unwrap(wrapped).reduce(startValue, f));
 }
 
@@ -320,13 +602,24 @@ ObservableImpl ObservableImpl::sample(const juce::RelativeTime& interval) const
     return wrap(unwrap(wrapped).sample_with_time(durationFromRelativeTime(interval)));
 }
 
+ObservableImpl ObservableImpl::sample(const juce::RelativeTime& interval, const SchedulerImpl& scheduler) const
+{
+    return wrap(PushSourcePtr(new detail::PushSampleSource<any>(toPushSource(wrapped), interval, scheduler.createWorker)));
+}
+
 ObservableImpl ObservableImpl::scan(const any& startValue, const std::function<any(const any&, const any&)>& f) const
 {
+    if (isNative(wrapped))
+        return wrapNative(wrapped, [startValue, f](const PushSourcePtr& source) { return detail::pushScan<any>(source, startValue, f); });
+
     return wrap(unwrap(wrapped).scan(startValue, f));
 }
 
 ObservableImpl ObservableImpl::skip(unsigned int numValues) const
 {
+    if (isNative(wrapped))
+        return wrapNative(wrapped, [numValues](const PushSourcePtr& source) { return detail::pushSkip<any>(source, numValues); });
+
     return wrap(unwrap(wrapped).skip(numValues));
 }
 
@@ -340,17 +633,25 @@ ObservableImpl ObservableImpl::startWith(juce::Array<any>&& values) const
     REAX_OBSERVABLE_IMPL_UNROLLED_LIST_IMPLEMENTATION(startWith, values);
 }
 
+ObservableImpl ObservableImpl::switchMap(const std::function<ObservableImpl(const any&)>& f) const
+{
+    return wrap(PushSourcePtr(new detail::PushSwitchMapSource<any, any>(toPushSource(wrapped), [f](const any& value) {
+        return toPushSource(f(value).wrapped);
+    })));
+}
+
 ObservableImpl ObservableImpl::switchOnNext() const
 {
-    rxcpp::observable<rxcpp::observable<any>> unwrapped = unwrap(wrapped).map([](const any& observable) {
-        return unwrap(observable.get<ObservableImpl>().wrapped);
+    return switchMap([](const any& observable) {
+        return observable.get<ObservableImpl>();
     });
-
-    return wrap(unwrapped.switch_on_next());
 }
 
 ObservableImpl ObservableImpl::take(unsigned int numValues) const
 {
+    if (isNative(wrapped))
+        return wrapNative(wrapped, [numValues](const PushSourcePtr& source) { return detail::pushTake<any>(source, numValues); });
+
     return wrap(unwrap(wrapped).take(numValues));
 }
 
@@ -366,8 +667,7 @@ ObservableImpl ObservableImpl::takeUntil(const ObservableImpl& other) const
 
 ObservableImpl ObservableImpl::takeWhile(const std::function<bool(const any&)>& predicate) const
 {
-    // On Visual Studio, the predicate must be wrapped in a lambda, otherwise RxCpp fails to compile
-    return wrap(unwrap(wrapped).take_while([predicate](const any& value) { return predicate(value); }));
+    return ObservableImpl(fuse(wrapped, FusedStages::Kind::TakeWhile, nullptr, predicate));
 }
 
 ObservableImpl ObservableImpl::withLatestFrom(std::initializer_list<ObservableImpl> others, const any& function) const {
@@ -384,7 +684,36 @@ ObservableImpl ObservableImpl::zip(std::initializer_list<ObservableImpl> others,
 
 ObservableImpl ObservableImpl::observeOn(const SchedulerImpl& scheduler) const
 {
-    return wrap(scheduler.schedule(unwrap(wrapped)));
+    // An unbounded queue: Each burst of values is emitted as one batch, from one scheduled action
+    return observeOn(scheduler, 0, PushOverflow::Block);
+}
+
+ObservableImpl ObservableImpl::observeOn(const SchedulerImpl& scheduler, size_t capacity, PushOverflow overflow) const
+{
+    return wrap(PushSourcePtr(new detail::PushObserveOnSource<any>(toPushSource(wrapped), scheduler.createWorker, capacity, overflow)));
+}
+
+ObservableImpl ObservableImpl::observeOnLatest(const SchedulerImpl& scheduler) const
+{
+    return wrap(PushSourcePtr(new detail::PushObserveOnLatestSource<any>(toPushSource(wrapped), scheduler.createWorker)));
+}
+
+
+#pragma mark - Multicasting
+
+ObservableImpl ObservableImpl::publish(size_t bufferSize) const
+{
+    return any(PushConnectablePtr(new detail::PushConnectable<any>(toPushSource(wrapped), bufferSize)));
+}
+
+Subscription ObservableImpl::connect() const
+{
+    return Subscription(any(wrapped.get<PushConnectablePtr>()->connect()));
+}
+
+ObservableImpl ObservableImpl::refCount() const
+{
+    return wrap(PushSourcePtr(new detail::PushRefCountSource<any>(wrapped.get<PushConnectablePtr>())));
 }
 
 
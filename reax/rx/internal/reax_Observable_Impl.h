@@ -18,6 +18,7 @@ struct ObservableImpl
     static ObservableImpl from(juce::Array<any>&& values);
     static ObservableImpl fromValue(juce::Value value);
     static ObservableImpl interval(const juce::RelativeTime& interval);
+    static ObservableImpl interval(const juce::RelativeTime& interval, const SchedulerImpl& scheduler);
     static ObservableImpl just(const any& value);
     static ObservableImpl never();
     static ObservableImpl integralRange(long long first, long long last, unsigned int step);
@@ -31,23 +32,30 @@ struct ObservableImpl
                          const std::function<void(std::exception_ptr)>& onError,
                          const std::function<void()>& onCompleted) const;
     Subscription subscribe(const ObserverImpl& observer) const;
+    Subscription subscribeWithDemand(unsigned int initialDemand,
+                                     const std::function<void(const any&)>& onNext,
+                                     const std::function<void(std::exception_ptr)>& onError,
+                                     const std::function<void()>& onCompleted) const;
 
     // Operators
     ObservableImpl combineLatest(std::initializer_list<ObservableImpl> others, const any& function) const;
     ObservableImpl concat(const juce::Array<ObservableImpl>& others) const;
     ObservableImpl debounce(const juce::RelativeTime& interval) const;
+    ObservableImpl debounce(const juce::RelativeTime& interval, const SchedulerImpl& scheduler) const;
     ObservableImpl distinctUntilChanged(const std::function<bool(const any&, const any&)>& equals) const;
     ObservableImpl elementAt(int index) const;
     ObservableImpl filter(const std::function<bool(const any&)>& predicate) const;
-    ObservableImpl flatMap(const std::function<ObservableImpl(const any&)>& function) const;
+    ObservableImpl flatMap(const std::function<ObservableImpl(const any&)>& function, unsigned int maxConcurrent, unsigned int prefetch) const;
     ObservableImpl map(const std::function<any(const any&)>& function) const;
     ObservableImpl merge(const juce::Array<ObservableImpl>& others) const;
     ObservableImpl reduce(const any& startValue, const std::function<any(const any&, const any&)>& f) const;
     ObservableImpl sample(const juce::RelativeTime& interval) const;
+    ObservableImpl sample(const juce::RelativeTime& interval, const SchedulerImpl& scheduler) const;
     ObservableImpl scan(const any& startValue, const std::function<any(const any&, const any&)>& f) const;
     ObservableImpl skip(unsigned int numValues) const;
     ObservableImpl skipUntil(const ObservableImpl& other) const;
     ObservableImpl startWith(juce::Array<any>&& values) const;
+    ObservableImpl switchMap(const std::function<ObservableImpl(const any&)>& function) const;
     ObservableImpl switchOnNext() const;
     ObservableImpl take(unsigned int numValues) const;
     ObservableImpl takeLast(unsigned int numValues) const;
@@ -58,6 +66,13 @@ struct ObservableImpl
 
     // Scheduling
     ObservableImpl observeOn(const SchedulerImpl& scheduler) const;
+    ObservableImpl observeOn(const SchedulerImpl& scheduler, size_t capacity, PushOverflow overflow) const;
+    ObservableImpl observeOnLatest(const SchedulerImpl& scheduler) const;
+
+    // Multicasting
+    ObservableImpl publish(size_t bufferSize) const;
+    Subscription connect() const;
+    ObservableImpl refCount() const;
 
     // Misc
     juce::Array<any> toArray(const std::function<void(std::exception_ptr)>& onError) const;
@@ -66,10 +81,10 @@ struct ObservableImpl
     [[ noreturn ]] static void TerminateOnError(std::exception_ptr);
     static void EmptyOnCompleted();
     
-    // The maximum number of parameters for operators like combineLatest, merge, zip, etc., NOT including the observable it is called on
+    // The maximum number of parameters for operators like combineLatest, withLatestFrom and zip, NOT including the observable it is called on. merge and concat take any number of Observables.
     static const int MaximumArity = 7;
 
-    // The wrapped rxcpp::observable<any>
+    // The wrapped rxcpp::observable<any>, or a block of fused map/filter/takeWhile stages that is turned into one on subscription
     any wrapped;
 };
 }
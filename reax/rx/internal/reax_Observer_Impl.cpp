@@ -3,18 +3,63 @@ ObserverImpl::ObserverImpl(const any& wrapped)
 : wrapped(wrapped)
 {}
 
-void ObserverImpl::onNext(any&& next) const
+void ObserverImpl::onNext(const any& next) const
 {
-    wrapped.get<rxcpp::subscriber<any>>().on_next(std::move(next));
+    const auto& handle = wrapped.get<PushObserverHandle<any>>();
+
+    // Like an rxcpp subscriber, ignore values after the subscription has ended
+    if (handle.subscription == nullptr || !handle.subscription->isUnsubscribed())
+        handle.observer->onNext(next);
+}
+
+void ObserverImpl::onNextBatch(const any* values, size_t numValues) const
+{
+    const auto& handle = wrapped.get<PushObserverHandle<any>>();
+
+    if (handle.subscription == nullptr || !handle.subscription->isUnsubscribed())
+        handle.observer->onNextBatch(values, numValues);
 }
 
 void ObserverImpl::onError(std::exception_ptr error) const
 {
-    wrapped.get<rxcpp::subscriber<any>>().on_error(error);
+    const auto& handle = wrapped.get<PushObserverHandle<any>>();
+
+    if (handle.subscription == nullptr || !handle.subscription->isUnsubscribed())
+        handle.observer->onError(error);
 }
 
 void ObserverImpl::onCompleted() const
 {
-    wrapped.get<rxcpp::subscriber<any>>().on_completed();
+    const auto& handle = wrapped.get<PushObserverHandle<any>>();
+
+    if (handle.subscription == nullptr || !handle.subscription->isUnsubscribed())
+        handle.observer->onCompleted();
+}
+
+void ObserverImpl::addTeardown(const std::function<void()>& teardown) const
+{
+    const auto& subscription = wrapped.get<PushObserverHandle<any>>().subscription;
+
+    // Only Observers passed to Observable::create have a subscription
+    jassert(subscription != nullptr);
+
+    if (subscription != nullptr)
+        subscription->add(teardown);
+}
+
+bool ObserverImpl::hasDemand() const
+{
+    const auto& subscription = wrapped.get<PushObserverHandle<any>>().subscription;
+
+    // Observers without a subscription (like the Observer side of a Subject) always have demand
+    return (subscription == nullptr || subscription->hasDemand());
+}
+
+void ObserverImpl::setOnRequest(const std::function<void()>& onRequest) const
+{
+    const auto& subscription = wrapped.get<PushObserverHandle<any>>().subscription;
+
+    if (subscription != nullptr)
+        subscription->setRequestHandler(onRequest);
 }
 }
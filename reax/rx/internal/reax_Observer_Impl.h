@@ -4,9 +4,13 @@ namespace detail {
     struct ObserverImpl
     {
         ObserverImpl(const any& wrapped);
-        void onNext(any&& next) const;
+        void onNext(const any& next) const;
+        void onNextBatch(const any* values, size_t numValues) const;
         void onError(std::exception_ptr error) const;
         void onCompleted() const;
+        void addTeardown(const std::function<void()>& teardown) const;
+        bool hasDemand() const;
+        void setOnRequest(const std::function<void()>& onRequest) const;
         
         const any wrapped;
     };
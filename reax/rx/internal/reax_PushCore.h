@@ -0,0 +1,3342 @@
+#pragma once
+
+namespace detail {
+/**
+ The lifetime of a subscription in the push core. Unsubscribing calls all teardown functions that have been added.
+
+ It's shared by all operators in a subscribed chain (like the subscriber lifetime in rxcpp). Operators that complete early (like take) unsubscribe it, to stop the upstream sources.
+ */
+class PushSubscription : public juce::ReferenceCountedObject
+{
+public:
+    typedef juce::ReferenceCountedObjectPtr<PushSubscription> Ptr;
+    typedef juce::uint64 TeardownId;
+
+    bool isUnsubscribed() const noexcept
+    {
+        return (unsubscribed.get() != 0);
+    }
+
+    // Adds a function that is called on unsubscribe, and returns an ID for remove(). If this is already unsubscribed, the function is called immediately, and the ID is 0.
+    TeardownId add(const std::function<void()>& teardown)
+    {
+        {
+            const juce::ScopedLock lock(teardownsLock);
+
+            if (!isUnsubscribed()) {
+                teardowns.emplace_back(++lastTeardownId, teardown);
+                return lastTeardownId;
+            }
+        }
+
+        teardown();
+        return 0;
+    }
+
+    // Removes a teardown function without calling it, e.g. because the child subscription that it would end has ended already
+    void remove(TeardownId id)
+    {
+        // Destroyed outside of the lock, because it may release a subscription
+        std::function<void()> removed;
+
+        {
+            const juce::ScopedLock lock(teardownsLock);
+
+            for (auto it = teardowns.begin(); it != teardowns.end(); ++it) {
+                if (it->first == id) {
+                    removed.swap(it->second);
+                    teardowns.erase(it);
+                    break;
+                }
+            }
+        }
+    }
+
+    size_t getNumTeardowns() const
+    {
+        const juce::ScopedLock lock(teardownsLock);
+        return teardowns.size();
+    }
+
+    void unsubscribe()
+    {
+        std::vector<std::pair<TeardownId, std::function<void()>>> toCall;
+        std::function<void()> requestHandler;
+
+        {
+            const juce::ScopedLock lock(teardownsLock);
+
+            if (unsubscribed.exchange(1) != 0)
+                return;
+
+            toCall.swap(teardowns);
+            requestHandler.swap(onRequest);
+        }
+
+        for (auto& teardown : toCall)
+            teardown.second();
+    }
+
+    // Flow control: A subscription has unbounded demand, unless the subscriber limits it. Producers that support flow control only emit while hasDemand() is true, and continue when the request handler is called. The subscriber consumes one unit of demand per received value.
+    static const juce::int64 UnboundedDemand = std::numeric_limits<juce::int64>::max();
+
+    // Must be called before subscribing
+    void limitDemand(juce::int64 initialDemand)
+    {
+        demand = initialDemand;
+    }
+
+    void request(juce::int64 numValues)
+    {
+        if (numValues <= 0 || demand.get() == UnboundedDemand)
+            return;
+
+        demand += numValues;
+
+        std::function<void()> requestHandler;
+
+        {
+            const juce::ScopedLock lock(teardownsLock);
+            requestHandler = onRequest;
+        }
+
+        if (requestHandler)
+            requestHandler();
+    }
+
+    void consume(juce::int64 numValues)
+    {
+        if (demand.get() != UnboundedDemand)
+            demand -= numValues;
+    }
+
+    bool hasDemand() const noexcept
+    {
+        return (demand.get() > 0);
+    }
+
+    juce::int64 getDemand() const noexcept
+    {
+        return demand.get();
+    }
+
+    // Sets the function that is called when the subscriber requests more values. It may be called on any thread.
+    void setRequestHandler(const std::function<void()>& requestHandler)
+    {
+        const juce::ScopedLock lock(teardownsLock);
+
+        if (!isUnsubscribed())
+            onRequest = requestHandler;
+    }
+
+private:
+    juce::Atomic<int> unsubscribed;
+    juce::Atomic<juce::int64> demand{ UnboundedDemand };
+    juce::CriticalSection teardownsLock;
+    std::vector<std::pair<TeardownId, std::function<void()>>> teardowns;
+    TeardownId lastTeardownId = 0;
+    std::function<void()> onRequest;
+};
+
+/**
+ Receives values in the push core. Calls to onNext, onNextBatch, onError and onCompleted are serialized, as in rxcpp.
+
+ onNextBatch receives a contiguous span of values. By default, it passes them to onNext one at a time. Operators that can process a whole span at once override it. An observer must ignore values after its subscription has ended, because a batch may end the subscription halfway through (like take).
+ */
+template<typename T>
+class PushObserver : public juce::ReferenceCountedObject
+{
+public:
+    typedef juce::ReferenceCountedObjectPtr<PushObserver> Ptr;
+
+    virtual void onNext(const T& value) = 0;
+
+    virtual void onNextBatch(const T* values, size_t numValues)
+    {
+        for (size_t i = 0; i < numValues; i++)
+            onNext(values[i]);
+    }
+
+    virtual void onError(std::exception_ptr error) = 0;
+    virtual void onCompleted() = 0;
+};
+
+/// Emits values to PushObservers. Each call to subscribe starts a new subscription, until the given PushSubscription is unsubscribed.
+template<typename T>
+class PushSource : public juce::ReferenceCountedObject
+{
+public:
+    typedef juce::ReferenceCountedObjectPtr<PushSource> Ptr;
+
+    virtual void subscribe(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription) = 0;
+};
+
+
+#pragma mark - Helpers
+
+// Holds the result of a user function, without requiring T to be default-constructible.
+template<typename T>
+class PushResult
+{
+public:
+    PushResult() noexcept
+    {}
+
+    ~PushResult()
+    {
+        if (hasValue)
+            get().~T();
+    }
+
+    template<typename Function, typename... Args>
+    void emplace(Function& function, Args&&... args)
+    {
+        new (&storage) T(function(std::forward<Args>(args)...));
+        hasValue = true;
+    }
+
+    T& get() noexcept
+    {
+        return *reinterpret_cast<T*>(&storage);
+    }
+
+private:
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    bool hasValue = false;
+
+    JUCE_DECLARE_NON_COPYABLE(PushResult)
+};
+
+// Base class for observers that forward onError and onCompleted to a downstream observer
+template<typename T, typename U = T>
+class PushForwardingObserver : public PushObserver<T>
+{
+public:
+    PushForwardingObserver(const typename PushObserver<U>::Ptr& downstream, const PushSubscription::Ptr& subscription)
+    : downstream(downstream),
+      subscription(subscription)
+    {}
+
+    void onError(std::exception_ptr error) override
+    {
+        downstream->onError(error);
+    }
+
+    void onCompleted() override
+    {
+        downstream->onCompleted();
+    }
+
+protected:
+    const typename PushObserver<U>::Ptr downstream;
+    const PushSubscription::Ptr subscription;
+
+    // Whether the subscription has ended. onNext and onNextBatch must return early in that case, because the default onNextBatch keeps calling onNext after an operator (like take) has ended the subscription.
+    bool hasEnded() const noexcept
+    {
+        return subscription->isUnsubscribed();
+    }
+
+    // Calls a user function. If it throws, the exception is forwarded to the downstream onError (like in rxcpp) and false is returned.
+    template<typename R, typename Function, typename... Args>
+    bool tryCall(PushResult<R>& result, Function& function, Args&&... args)
+    {
+        const std::exception_ptr error = tryEmplace(result, function, std::forward<Args>(args)...);
+
+        if (error)
+            downstream->onError(error);
+
+        return !error;
+    }
+
+    // Calls a user function, and returns the exception if it throws. Used in onNextBatch, to emit the values before the failed one first.
+    template<typename R, typename Function, typename... Args>
+    static std::exception_ptr tryEmplace(PushResult<R>& result, Function& function, Args&&... args)
+    {
+        try {
+            result.emplace(function, std::forward<Args>(args)...);
+            return std::exception_ptr();
+        }
+        catch (...) {
+            return std::current_exception();
+        }
+    }
+};
+
+// A source that applies an operator to each new subscription of an upstream source. makeObserver wraps the downstream observer.
+template<typename T, typename U, typename MakeObserver>
+class PushLiftSource : public PushSource<U>
+{
+public:
+    PushLiftSource(const typename PushSource<T>::Ptr& upstream, const MakeObserver& makeObserver)
+    : upstream(upstream),
+      makeObserver(makeObserver)
+    {}
+
+    void subscribe(const typename PushObserver<U>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        upstream->subscribe(makeObserver(observer, subscription), subscription);
+    }
+
+private:
+    const typename PushSource<T>::Ptr upstream;
+    const MakeObserver makeObserver;
+};
+
+template<typename T, typename U, typename MakeObserver>
+typename PushSource<U>::Ptr pushLift(const typename PushSource<T>::Ptr& upstream, const MakeObserver& makeObserver)
+{
+    return new PushLiftSource<T, U, MakeObserver>(upstream, makeObserver);
+}
+
+
+#pragma mark - Sources
+
+// A source that calls a function on each subscription
+template<typename T>
+class PushCreateSource : public PushSource<T>
+{
+public:
+    typedef std::function<void(const typename PushObserver<T>::Ptr&, const PushSubscription::Ptr&)> OnSubscribe;
+
+    explicit PushCreateSource(const OnSubscribe& onSubscribe)
+    : onSubscribe(onSubscribe)
+    {}
+
+    void subscribe(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        // Exceptions on subscribe are forwarded to onError, like in rxcpp
+        try {
+            onSubscribe(observer, subscription);
+        }
+        catch (...) {
+            observer->onError(std::current_exception());
+        }
+    }
+
+private:
+    const OnSubscribe onSubscribe;
+};
+
+// A source that emits the values from an Array and completes
+template<typename T>
+class PushFromSource : public PushSource<T>
+{
+public:
+    explicit PushFromSource(juce::Array<T>&& values)
+    : values(std::move(values))
+    {}
+
+    void subscribe(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        if (!values.isEmpty())
+            observer->onNextBatch(values.begin(), static_cast<size_t>(values.size()));
+
+        if (!subscription->isUnsubscribed())
+            observer->onCompleted();
+    }
+
+private:
+    const juce::Array<T> values;
+};
+
+// A source that doesn't emit any values, and optionally completes or fails on subscribe
+template<typename T>
+class PushTerminalSource : public PushSource<T>
+{
+public:
+    enum class Kind {
+        Empty,
+        Never,
+        Error
+    };
+
+    explicit PushTerminalSource(Kind kind, std::exception_ptr error = std::exception_ptr())
+    : kind(kind),
+      error(error)
+    {}
+
+    void subscribe(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr&) override
+    {
+        switch (kind) {
+            case Kind::Empty:
+                observer->onCompleted();
+                break;
+            case Kind::Error:
+                observer->onError(error);
+                break;
+            case Kind::Never:
+                break;
+        }
+    }
+
+private:
+    const Kind kind;
+    const std::exception_ptr error;
+};
+
+/**
+ A hot source that emits the values passed to onNext to all subscribed observers. Thread-safe.
+
+ The list of observers is immutable and replaced on each subscribe/unsubscribe. So emitting a value doesn't allocate or copy the list, and observers may subscribe or unsubscribe while a value is being emitted. Without a buffer, emitting doesn't take a lock either: The current list is published through an atomic pointer (see loadObservers).
+
+ It can remember the last `bufferSize` values, and emits them to each new observer (like a BehaviorSubject or ReplaySubject). If `replaysAfterTermination` is false, observers that subscribe after onError or onCompleted only get the terminal notification.
+ */
+template<typename T>
+class PushSubject : public PushSource<T>
+{
+public:
+    typedef juce::ReferenceCountedObjectPtr<PushSubject> Ptr;
+
+    explicit PushSubject(size_t bufferSize = 0, bool replaysAfterTermination = true)
+    : bufferSize(bufferSize),
+      replaysAfterTermination(replaysAfterTermination)
+    {}
+
+    void subscribe(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        bool wasTerminated;
+        std::deque<T> replayed;
+
+        // While the buffer is replayed to a new observer, new notifications for it are held back by a gate. So they arrive after the replayed values, and never at the same time.
+        typename ReplayGate::Ptr gate;
+
+        {
+            const juce::ScopedLock lock(observersLock);
+            wasTerminated = terminated;
+
+            if (!terminated || replaysAfterTermination)
+                replayed = buffer;
+
+            if (!terminated) {
+                typename ObserverList::Ptr newList(new ObserverList());
+
+                if (observers != nullptr)
+                    newList->entries = observers->entries;
+
+                if (!replayed.empty())
+                    gate = new ReplayGate(observer, subscription);
+
+                newList->entries.push_back({ (gate != nullptr ? typename PushObserver<T>::Ptr(gate.get()) : observer), subscription });
+                publish(newList);
+            }
+        }
+
+        if (!wasTerminated) {
+            Ptr self(this);
+            PushObserver<T>* const toRemove = (gate != nullptr ? gate.get() : observer.get());
+            subscription->add([self, toRemove]() {
+                self->remove(toRemove);
+            });
+        }
+
+        if (gate != nullptr) {
+            gate->replay(replayed);
+            return;
+        }
+
+        for (auto& value : replayed) {
+            if (subscription->isUnsubscribed())
+                return;
+
+            observer->onNext(value);
+        }
+
+        if (wasTerminated)
+            notifyTerminated(*observer);
+    }
+
+    void onNext(const T& value)
+    {
+        typename ObserverList::Ptr list;
+
+        if (bufferSize == 0) {
+            list = loadObservers();
+        }
+        else {
+            const juce::ScopedLock lock(observersLock);
+
+            if (terminated)
+                return;
+
+            addToBuffer(value);
+            list = observers;
+        }
+
+        if (list == nullptr)
+            return;
+
+        for (auto& entry : list->entries) {
+            if (!entry.subscription->isUnsubscribed())
+                entry.observer->onNext(value);
+        }
+    }
+
+    // Emits a span of values to each observer at once
+    void onNextBatch(const T* values, size_t numValues)
+    {
+        typename ObserverList::Ptr list;
+
+        if (bufferSize == 0) {
+            list = loadObservers();
+        }
+        else {
+            const juce::ScopedLock lock(observersLock);
+
+            if (terminated)
+                return;
+
+            for (size_t i = (numValues > bufferSize ? numValues - bufferSize : 0); i < numValues; i++)
+                addToBuffer(values[i]);
+
+            list = observers;
+        }
+
+        if (list == nullptr)
+            return;
+
+        for (auto& entry : list->entries) {
+            if (!entry.subscription->isUnsubscribed())
+                entry.observer->onNextBatch(values, numValues);
+        }
+    }
+
+    void onError(std::exception_ptr error)
+    {
+        terminate(true, error);
+    }
+
+    void onCompleted()
+    {
+        terminate(false, std::exception_ptr());
+    }
+
+    bool hasObservers() const
+    {
+        const juce::ScopedLock lock(observersLock);
+        return (observers != nullptr && !observers->entries.empty());
+    }
+
+    bool isTerminated() const
+    {
+        const juce::ScopedLock lock(observersLock);
+        return terminated;
+    }
+
+    // Returns the most recent value. The buffer must not be empty.
+    T getLatestValue() const
+    {
+        const juce::ScopedLock lock(observersLock);
+        jassert(!buffer.empty());
+
+        return buffer.back();
+    }
+
+private:
+    struct Entry
+    {
+        typename PushObserver<T>::Ptr observer;
+        PushSubscription::Ptr subscription;
+    };
+
+    struct ObserverList : public juce::ReferenceCountedObject
+    {
+        typedef juce::ReferenceCountedObjectPtr<ObserverList> Ptr;
+        std::vector<Entry> entries;
+    };
+
+    // Holds back the notifications for an observer while the buffer is replayed to it. Notifications from other threads wait until the replay has finished. Notifications that the observer causes itself (on the replaying thread) are queued, and emitted after the replayed values.
+    class ReplayGate : public PushObserver<T>
+    {
+    public:
+        typedef juce::ReferenceCountedObjectPtr<ReplayGate> Ptr;
+
+        ReplayGate(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription)
+        : observer(observer),
+          subscription(subscription)
+        {}
+
+        void onNext(const T& value) override
+        {
+            if (!isOpen.get()) {
+                const juce::ScopedLock scopedLock(lock);
+
+                if (isReplaying) {
+                    pending.push_back(value);
+                    return;
+                }
+            }
+
+            observer->onNext(value);
+        }
+
+        void onNextBatch(const T* values, size_t numValues) override
+        {
+            if (!isOpen.get()) {
+                const juce::ScopedLock scopedLock(lock);
+
+                if (isReplaying) {
+                    pending.insert(pending.end(), values, values + numValues);
+                    return;
+                }
+            }
+
+            observer->onNextBatch(values, numValues);
+        }
+
+        void onError(std::exception_ptr error) override
+        {
+            if (!isOpen.get()) {
+                const juce::ScopedLock scopedLock(lock);
+
+                if (isReplaying) {
+                    pendingTermination = Termination::Error;
+                    terminationError = error;
+                    return;
+                }
+            }
+
+            observer->onError(error);
+        }
+
+        void onCompleted() override
+        {
+            if (!isOpen.get()) {
+                const juce::ScopedLock scopedLock(lock);
+
+                if (isReplaying) {
+                    pendingTermination = Termination::Completed;
+                    return;
+                }
+            }
+
+            observer->onCompleted();
+        }
+
+        // Emits the replayed values, and then the queued notifications. Afterwards, notifications are passed on directly.
+        void replay(const std::deque<T>& values)
+        {
+            const juce::ScopedLock scopedLock(lock);
+
+            for (auto& value : values) {
+                if (subscription->isUnsubscribed())
+                    break;
+
+                observer->onNext(value);
+            }
+
+            // The observer may cause more values while they are emitted
+            while (!pending.empty() && !subscription->isUnsubscribed()) {
+                const T value(std::move(pending.front()));
+                pending.pop_front();
+                observer->onNext(value);
+            }
+
+            pending.clear();
+            isReplaying = false;
+            isOpen = 1;
+
+            if (pendingTermination != Termination::None && !subscription->isUnsubscribed()) {
+                if (pendingTermination == Termination::Error)
+                    observer->onError(terminationError);
+                else
+                    observer->onCompleted();
+            }
+        }
+
+    private:
+        enum class Termination {
+            None,
+            Completed,
+            Error
+        };
+
+        const typename PushObserver<T>::Ptr observer;
+        const PushSubscription::Ptr subscription;
+        juce::CriticalSection lock;
+        juce::Atomic<int> isOpen;
+        bool isReplaying = true;
+        std::deque<T> pending;
+        Termination pendingTermination = Termination::None;
+        std::exception_ptr terminationError;
+    };
+
+    const size_t bufferSize;
+    const bool replaysAfterTermination;
+    juce::CriticalSection observersLock;
+    typename ObserverList::Ptr observers;
+    juce::Atomic<ObserverList*> publishedObservers;
+    mutable juce::Atomic<int> readerEpoch;
+    mutable juce::Atomic<int> numReaders[2];
+    std::deque<T> buffer;
+    bool terminated = false;
+    bool failed = false;
+    std::exception_ptr error;
+
+    /*
+     Returns a reference to the current list, without taking observersLock.
+
+     A reader announces itself in the counter of the current epoch (0 or 1) before it loads the pointer, and leaves after it has taken its reference. publish switches the epoch after it has replaced the pointer, and waits until the counter of the previous epoch is 0 before it releases the old list. New readers use the other counter, so publish only waits for the few readers that may still be loading the old pointer, never for an emission.
+
+     If the epoch has changed between reading it and announcing itself, the reader may have announced itself in a counter that publish no longer waits for. So it leaves, and tries again with the new epoch.
+     */
+    typename ObserverList::Ptr loadObservers() const
+    {
+        for (;;) {
+            const int epoch = readerEpoch.get();
+            juce::Atomic<int>& readers = numReaders[epoch];
+            ++readers;
+
+            if (readerEpoch.get() != epoch) {
+                --readers;
+                continue;
+            }
+
+            const typename ObserverList::Ptr list(publishedObservers.get());
+            --readers;
+
+            return list;
+        }
+    }
+
+    // Replaces the list of observers. Must be called with observersLock held.
+    void publish(typename ObserverList::Ptr newList)
+    {
+        publishedObservers = newList.get();
+        const int previousEpoch = readerEpoch.get();
+        readerEpoch = 1 - previousEpoch;
+
+        while (numReaders[previousEpoch].get() != 0)
+            juce::Thread::yield();
+
+        // The old list is released when newList goes out of scope
+        std::swap(observers, newList);
+    }
+
+    void addToBuffer(const T& value)
+    {
+        // Reuse the single slot (e.g. for a BehaviorSubject), so emitting doesn't allocate
+        if (bufferSize == 1 && !buffer.empty()) {
+            buffer.front() = value;
+            return;
+        }
+
+        if (buffer.size() == bufferSize)
+            buffer.pop_front();
+
+        buffer.push_back(value);
+    }
+
+    void remove(PushObserver<T>* observer)
+    {
+        const juce::ScopedLock lock(observersLock);
+
+        if (observers == nullptr)
+            return;
+
+        typename ObserverList::Ptr newList(new ObserverList());
+
+        for (auto& entry : observers->entries) {
+            if (entry.observer.get() != observer)
+                newList->entries.push_back(entry);
+        }
+
+        publish(newList);
+    }
+
+    void terminate(bool isError, std::exception_ptr terminalError)
+    {
+        typename ObserverList::Ptr list;
+
+        {
+            const juce::ScopedLock lock(observersLock);
+
+            if (terminated)
+                return;
+
+            terminated = true;
+            failed = isError;
+            error = terminalError;
+            list = observers;
+            publish(nullptr);
+        }
+
+        if (list == nullptr)
+            return;
+
+        for (auto& entry : list->entries) {
+            if (!entry.subscription->isUnsubscribed())
+                notifyTerminated(*entry.observer);
+        }
+    }
+
+    void notifyTerminated(PushObserver<T>& observer) const
+    {
+        // The error may be an empty exception_ptr, so it can't be used to tell whether this failed
+        if (failed)
+            observer.onError(error);
+        else
+            observer.onCompleted();
+    }
+};
+
+// An observer that pushes values into a PushSubject
+template<typename T>
+class PushSubjectObserver : public PushObserver<T>
+{
+public:
+    explicit PushSubjectObserver(const typename PushSubject<T>::Ptr& subject)
+    : subject(subject)
+    {}
+
+    void onNext(const T& value) override
+    {
+        subject->onNext(value);
+    }
+
+    void onNextBatch(const T* values, size_t numValues) override
+    {
+        subject->onNextBatch(values, numValues);
+    }
+
+    void onError(std::exception_ptr error) override
+    {
+        subject->onError(error);
+    }
+
+    void onCompleted() override
+    {
+        subject->onCompleted();
+    }
+
+private:
+    const typename PushSubject<T>::Ptr subject;
+};
+
+
+#pragma mark - Operators
+
+template<typename T, typename U, typename Function>
+class PushMapObserver : public PushForwardingObserver<T, U>
+{
+public:
+    PushMapObserver(const typename PushObserver<U>::Ptr& downstream, const PushSubscription::Ptr& subscription, const Function& function)
+    : PushForwardingObserver<T, U>(downstream, subscription),
+      function(function)
+    {}
+
+    void onNext(const T& value) override
+    {
+        if (this->hasEnded())
+            return;
+
+        PushResult<U> result;
+
+        if (this->tryCall(result, function, value))
+            this->downstream->onNext(result.get());
+    }
+
+    // Maps the whole span into a reused buffer, and passes it on as one batch
+    void onNextBatch(const T* values, size_t numValues) override
+    {
+        if (this->hasEnded())
+            return;
+
+        // Take the storage, in case the downstream observer emits into this one again
+        juce::Array<U> results(std::move(storage));
+        results.clearQuick();
+        results.ensureStorageAllocated(static_cast<int>(numValues));
+        std::exception_ptr error;
+
+        for (size_t i = 0; i < numValues && !error; i++) {
+            PushResult<U> result;
+            error = this->tryEmplace(result, function, values[i]);
+
+            if (!error)
+                results.add(std::move(result.get()));
+        }
+
+        // Values before the one that failed are still emitted, like in onNext
+        if (!results.isEmpty())
+            this->downstream->onNextBatch(results.begin(), static_cast<size_t>(results.size()));
+
+        if (error)
+            this->downstream->onError(error);
+
+        results.clearQuick();
+        storage = std::move(results);
+    }
+
+private:
+    Function function;
+    juce::Array<U> storage;
+};
+
+template<typename U, typename T, typename Function>
+typename PushSource<U>::Ptr pushMap(const typename PushSource<T>::Ptr& upstream, const Function& function)
+{
+    return pushLift<T, U>(upstream, [function](const typename PushObserver<U>::Ptr& downstream, const PushSubscription::Ptr& subscription) {
+        return typename PushObserver<T>::Ptr(new PushMapObserver<T, U, Function>(downstream, subscription, function));
+    });
+}
+
+template<typename T, typename Predicate>
+class PushFilterObserver : public PushForwardingObserver<T>
+{
+public:
+    PushFilterObserver(const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription, const Predicate& predicate)
+    : PushForwardingObserver<T>(downstream, subscription),
+      predicate(predicate)
+    {}
+
+    void onNext(const T& value) override
+    {
+        if (this->hasEnded())
+            return;
+
+        PushResult<bool> passes;
+
+        if (this->tryCall(passes, predicate, value) && passes.get())
+            this->downstream->onNext(value);
+    }
+
+    // Passes on each run of consecutive values that pass the predicate as a sub-span, without copying them
+    void onNextBatch(const T* values, size_t numValues) override
+    {
+        size_t runStart = 0;
+
+        for (size_t i = 0; i < numValues && !this->hasEnded(); i++) {
+            PushResult<bool> passes;
+            const std::exception_ptr error = this->tryEmplace(passes, predicate, values[i]);
+
+            if (error) {
+                emitRun(values, runStart, i);
+                this->downstream->onError(error);
+                return;
+            }
+
+            if (!passes.get()) {
+                emitRun(values, runStart, i);
+                runStart = i + 1;
+            }
+        }
+
+        emitRun(values, runStart, numValues);
+    }
+
+private:
+    Predicate predicate;
+
+    void emitRun(const T* values, size_t start, size_t end)
+    {
+        if (end > start && !this->hasEnded())
+            this->downstream->onNextBatch(values + start, end - start);
+    }
+};
+
+template<typename T, typename Predicate>
+typename PushSource<T>::Ptr pushFilter(const typename PushSource<T>::Ptr& upstream, const Predicate& predicate)
+{
+    return pushLift<T, T>(upstream, [predicate](const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription) {
+        return typename PushObserver<T>::Ptr(new PushFilterObserver<T, Predicate>(downstream, subscription, predicate));
+    });
+}
+
+template<typename T, typename Predicate>
+class PushTakeWhileObserver : public PushForwardingObserver<T>
+{
+public:
+    PushTakeWhileObserver(const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription, const Predicate& predicate)
+    : PushForwardingObserver<T>(downstream, subscription),
+      predicate(predicate)
+    {}
+
+    void onNext(const T& value) override
+    {
+        if (this->hasEnded())
+            return;
+
+        PushResult<bool> passes;
+
+        if (!this->tryCall(passes, predicate, value))
+            return;
+
+        if (passes.get())
+            this->downstream->onNext(value);
+        else {
+            this->downstream->onCompleted();
+            this->subscription->unsubscribe();
+        }
+    }
+
+    // Passes on the values before the first one that doesn't pass the predicate as one span
+    void onNextBatch(const T* values, size_t numValues) override
+    {
+        if (this->hasEnded())
+            return;
+
+        for (size_t i = 0; i < numValues; i++) {
+            PushResult<bool> passes;
+            const std::exception_ptr error = this->tryEmplace(passes, predicate, values[i]);
+
+            if (error || !passes.get()) {
+                if (i > 0)
+                    this->downstream->onNextBatch(values, i);
+
+                if (error) {
+                    this->downstream->onError(error);
+                }
+                else {
+                    this->downstream->onCompleted();
+                    this->subscription->unsubscribe();
+                }
+
+                return;
+            }
+        }
+
+        if (numValues > 0)
+            this->downstream->onNextBatch(values, numValues);
+    }
+
+private:
+    Predicate predicate;
+};
+
+template<typename T, typename Predicate>
+typename PushSource<T>::Ptr pushTakeWhile(const typename PushSource<T>::Ptr& upstream, const Predicate& predicate)
+{
+    return pushLift<T, T>(upstream, [predicate](const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription) {
+        return typename PushObserver<T>::Ptr(new PushTakeWhileObserver<T, Predicate>(downstream, subscription, predicate));
+    });
+}
+
+// Implements scan and reduce. The accumulator is kept per subscription.
+template<typename T, typename Function>
+class PushScanObserver : public PushForwardingObserver<T>
+{
+public:
+    PushScanObserver(const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription, const T& startValue, const Function& function, bool emitsIntermediateValues)
+    : PushForwardingObserver<T>(downstream, subscription),
+      accumulator(startValue),
+      function(function),
+      emitsIntermediateValues(emitsIntermediateValues)
+    {}
+
+    void onNext(const T& value) override
+    {
+        if (this->hasEnded())
+            return;
+
+        PushResult<T> result;
+
+        if (!this->tryCall(result, function, accumulator, value))
+            return;
+
+        accumulator = std::move(result.get());
+
+        if (emitsIntermediateValues)
+            this->downstream->onNext(accumulator);
+    }
+
+    // Accumulates the whole span, and passes on the intermediate values as one batch
+    void onNextBatch(const T* values, size_t numValues) override
+    {
+        if (this->hasEnded())
+            return;
+
+        // Take the storage, in case the downstream observer emits into this one again
+        juce::Array<T> results(std::move(storage));
+        results.clearQuick();
+        std::exception_ptr error;
+
+        if (emitsIntermediateValues)
+            results.ensureStorageAllocated(static_cast<int>(numValues));
+
+        for (size_t i = 0; i < numValues; i++) {
+            PushResult<T> result;
+            error = this->tryEmplace(result, function, accumulator, values[i]);
+
+            if (error)
+                break;
+
+            accumulator = std::move(result.get());
+
+            if (emitsIntermediateValues)
+                results.add(accumulator);
+        }
+
+        if (!results.isEmpty())
+            this->downstream->onNextBatch(results.begin(), static_cast<size_t>(results.size()));
+
+        if (error)
+            this->downstream->onError(error);
+
+        results.clearQuick();
+        storage = std::move(results);
+    }
+
+    void onCompleted() override
+    {
+        if (!emitsIntermediateValues)
+            this->downstream->onNext(accumulator);
+
+        this->downstream->onCompleted();
+    }
+
+private:
+    T accumulator;
+    Function function;
+    const bool emitsIntermediateValues;
+    juce::Array<T> storage;
+};
+
+template<typename T, typename Function>
+typename PushSource<T>::Ptr pushScan(const typename PushSource<T>::Ptr& upstream, const T& startValue, const Function& function, bool emitsIntermediateValues = true)
+{
+    return pushLift<T, T>(upstream, [startValue, function, emitsIntermediateValues](const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription) {
+        return typename PushObserver<T>::Ptr(new PushScanObserver<T, Function>(downstream, subscription, startValue, function, emitsIntermediateValues));
+    });
+}
+
+template<typename T, typename Equals>
+class PushDistinctUntilChangedObserver : public PushForwardingObserver<T>
+{
+public:
+    PushDistinctUntilChangedObserver(const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription, const Equals& equals)
+    : PushForwardingObserver<T>(downstream, subscription),
+      equals(equals)
+    {}
+
+    void onNext(const T& value) override
+    {
+        if (this->hasEnded())
+            return;
+
+        if (hasPrevious) {
+            PushResult<bool> isEqual;
+
+            if (!this->tryCall(isEqual, equals, previous.get(), value) || isEqual.get())
+                return;
+
+            previous.get() = value;
+        }
+        else {
+            previous.emplace(copy, value);
+            hasPrevious = true;
+        }
+
+        this->downstream->onNext(value);
+    }
+
+private:
+    Equals equals;
+    PushResult<T> previous;
+    bool hasPrevious = false;
+
+    static T copy(const T& value)
+    {
+        return value;
+    }
+};
+
+template<typename T, typename Equals>
+typename PushSource<T>::Ptr pushDistinctUntilChanged(const typename PushSource<T>::Ptr& upstream, const Equals& equals)
+{
+    return pushLift<T, T>(upstream, [equals](const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription) {
+        return typename PushObserver<T>::Ptr(new PushDistinctUntilChangedObserver<T, Equals>(downstream, subscription, equals));
+    });
+}
+
+template<typename T>
+class PushSkipObserver : public PushForwardingObserver<T>
+{
+public:
+    PushSkipObserver(const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription, unsigned int numValues)
+    : PushForwardingObserver<T>(downstream, subscription),
+      remaining(numValues)
+    {}
+
+    void onNext(const T& value) override
+    {
+        if (this->hasEnded())
+            return;
+
+        if (remaining > 0)
+            remaining--;
+        else
+            this->downstream->onNext(value);
+    }
+
+    void onNextBatch(const T* values, size_t numValues) override
+    {
+        if (this->hasEnded())
+            return;
+
+        const size_t numSkipped = juce::jmin(static_cast<size_t>(remaining), numValues);
+        remaining -= static_cast<unsigned int>(numSkipped);
+
+        if (numValues > numSkipped)
+            this->downstream->onNextBatch(values + numSkipped, numValues - numSkipped);
+    }
+
+private:
+    unsigned int remaining;
+};
+
+template<typename T>
+typename PushSource<T>::Ptr pushSkip(const typename PushSource<T>::Ptr& upstream, unsigned int numValues)
+{
+    return pushLift<T, T>(upstream, [numValues](const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription) {
+        return typename PushObserver<T>::Ptr(new PushSkipObserver<T>(downstream, subscription, numValues));
+    });
+}
+
+template<typename T>
+class PushTakeObserver : public PushForwardingObserver<T>
+{
+public:
+    PushTakeObserver(const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription, unsigned int numValues)
+    : PushForwardingObserver<T>(downstream, subscription),
+      remaining(numValues)
+    {}
+
+    void onNext(const T& value) override
+    {
+        if (remaining == 0 || this->hasEnded())
+            return;
+
+        remaining--;
+        this->downstream->onNext(value);
+
+        if (remaining == 0) {
+            this->downstream->onCompleted();
+            this->subscription->unsubscribe();
+        }
+    }
+
+    void onNextBatch(const T* values, size_t numValues) override
+    {
+        if (remaining == 0 || numValues == 0 || this->hasEnded())
+            return;
+
+        const size_t numTaken = juce::jmin(static_cast<size_t>(remaining), numValues);
+        remaining -= static_cast<unsigned int>(numTaken);
+        this->downstream->onNextBatch(values, numTaken);
+
+        if (remaining == 0) {
+            this->downstream->onCompleted();
+            this->subscription->unsubscribe();
+        }
+    }
+
+private:
+    unsigned int remaining;
+};
+
+template<typename T>
+typename PushSource<T>::Ptr pushTake(const typename PushSource<T>::Ptr& upstream, unsigned int numValues)
+{
+    // take(0) completes immediately, without subscribing to the upstream source
+    if (numValues == 0)
+        return new PushTerminalSource<T>(PushTerminalSource<T>::Kind::Empty);
+
+    return pushLift<T, T>(upstream, [numValues](const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription) {
+        return typename PushObserver<T>::Ptr(new PushTakeObserver<T>(downstream, subscription, numValues));
+    });
+}
+
+
+#pragma mark - Combining
+
+// Returns a new subscription that is unsubscribed together with the parent. Used for sources that subscribe to multiple upstream sources, so one of them can complete early (like take) without ending the others.
+inline PushSubscription::Ptr pushChildSubscription(const PushSubscription::Ptr& parent, PushSubscription::TeardownId* teardownId = nullptr)
+{
+    const PushSubscription::Ptr child(new PushSubscription());
+    const PushSubscription::TeardownId id = parent->add([child]() { child->unsubscribe(); });
+
+    if (teardownId != nullptr)
+        *teardownId = id;
+
+    return child;
+}
+
+// Ends a child subscription before its parent, and removes it from the parent. Sources that subscribe to an open-ended number of upstream sources (like flatMap) call this when one of them has ended, so the parent doesn't keep a teardown for each of them.
+inline void pushEndChildSubscription(const PushSubscription::Ptr& parent, const PushSubscription::Ptr& child, PushSubscription::TeardownId teardownId)
+{
+    parent->remove(teardownId);
+    child->unsubscribe();
+}
+
+/**
+ Emits the values from any number of upstream sources, and completes when all of them have completed. An error from one of them is forwarded immediately, and ends the subscription.
+
+ Calls to the observer are serialized, so the upstream sources may emit on different threads.
+ */
+template<typename T>
+class PushMergeSource : public PushSource<T>
+{
+public:
+    explicit PushMergeSource(const std::vector<typename PushSource<T>::Ptr>& upstreams)
+    : upstreams(upstreams)
+    {}
+
+    void subscribe(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        if (upstreams.empty()) {
+            observer->onCompleted();
+            return;
+        }
+
+        const typename State::Ptr state(new State(observer, subscription, upstreams.size()));
+
+        for (auto& upstream : upstreams) {
+            if (subscription->isUnsubscribed())
+                return;
+
+            upstream->subscribe(new MergeObserver(state), pushChildSubscription(subscription));
+        }
+    }
+
+private:
+    struct State : public juce::ReferenceCountedObject
+    {
+        typedef juce::ReferenceCountedObjectPtr<State> Ptr;
+
+        State(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription, size_t numActive)
+        : observer(observer),
+          subscription(subscription),
+          numActive(numActive)
+        {}
+
+        const typename PushObserver<T>::Ptr observer;
+        const PushSubscription::Ptr subscription;
+        juce::CriticalSection lock;
+        size_t numActive;
+        bool terminated = false;
+    };
+
+    class MergeObserver : public PushObserver<T>
+    {
+    public:
+        explicit MergeObserver(const typename State::Ptr& state)
+        : state(state)
+        {}
+
+        void onNext(const T& value) override
+        {
+            const juce::ScopedLock lock(state->lock);
+
+            if (!state->terminated)
+                state->observer->onNext(value);
+        }
+
+        void onNextBatch(const T* values, size_t numValues) override
+        {
+            const juce::ScopedLock lock(state->lock);
+
+            if (!state->terminated)
+                state->observer->onNextBatch(values, numValues);
+        }
+
+        void onError(std::exception_ptr error) override
+        {
+            {
+                const juce::ScopedLock lock(state->lock);
+
+                if (state->terminated)
+                    return;
+
+                state->terminated = true;
+                state->observer->onError(error);
+            }
+
+            state->subscription->unsubscribe();
+        }
+
+        void onCompleted() override
+        {
+            const juce::ScopedLock lock(state->lock);
+
+            if (state->terminated || --state->numActive > 0)
+                return;
+
+            state->terminated = true;
+            state->observer->onCompleted();
+        }
+
+    private:
+        const typename State::Ptr state;
+    };
+
+    const std::vector<typename PushSource<T>::Ptr> upstreams;
+};
+
+/**
+ Emits the values from any number of upstream sources, one after the other. It subscribes to the next upstream source when the previous one has completed.
+
+ Upstream sources that complete synchronously are subscribed to in a loop, so a long list of them doesn't cause deep recursion.
+ */
+template<typename T>
+class PushConcatSource : public PushSource<T>
+{
+public:
+    explicit PushConcatSource(const std::vector<typename PushSource<T>::Ptr>& upstreams)
+    : upstreams(upstreams)
+    {}
+
+    void subscribe(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        const typename State::Ptr state(new State(upstreams, observer, subscription));
+        state->subscribeToNext();
+    }
+
+private:
+    class State : public juce::ReferenceCountedObject
+    {
+    public:
+        typedef juce::ReferenceCountedObjectPtr<State> Ptr;
+
+        State(const std::vector<typename PushSource<T>::Ptr>& upstreams, const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription)
+        : upstreams(upstreams),
+          observer(observer),
+          subscription(subscription)
+        {}
+
+        // Subscribes to the next upstream source, or completes if there are no more. If this is called while subscribing (because an upstream source completed synchronously), the loop continues instead.
+        void subscribeToNext()
+        {
+            {
+                const juce::ScopedLock lock(stateLock);
+                hasPendingSubscribe = true;
+
+                if (isSubscribing)
+                    return;
+
+                isSubscribing = true;
+            }
+
+            for (;;) {
+                typename PushSource<T>::Ptr next;
+
+                {
+                    const juce::ScopedLock lock(stateLock);
+
+                    if (!hasPendingSubscribe || subscription->isUnsubscribed()) {
+                        isSubscribing = false;
+                        return;
+                    }
+
+                    hasPendingSubscribe = false;
+
+                    if (nextIndex < upstreams.size())
+                        next = upstreams[nextIndex++];
+                }
+
+                if (next == nullptr) {
+                    observer->onCompleted();
+                    return;
+                }
+
+                // The child subscription is removed from the parent when the upstream source completes, so the parent doesn't keep a teardown for each of them
+                PushSubscription::TeardownId teardownId;
+                const PushSubscription::Ptr childSubscription = pushChildSubscription(subscription, &teardownId);
+                next->subscribe(new ConcatObserver(this, childSubscription, teardownId), childSubscription);
+            }
+        }
+
+        const std::vector<typename PushSource<T>::Ptr> upstreams;
+        const typename PushObserver<T>::Ptr observer;
+        const PushSubscription::Ptr subscription;
+
+    private:
+        juce::CriticalSection stateLock;
+        size_t nextIndex = 0;
+        bool isSubscribing = false;
+        bool hasPendingSubscribe = false;
+    };
+
+    class ConcatObserver : public PushObserver<T>
+    {
+    public:
+        ConcatObserver(const typename State::Ptr& state, const PushSubscription::Ptr& childSubscription, PushSubscription::TeardownId teardownId)
+        : state(state),
+          childSubscription(childSubscription),
+          teardownId(teardownId)
+        {}
+
+        void onNext(const T& value) override
+        {
+            state->observer->onNext(value);
+        }
+
+        void onNextBatch(const T* values, size_t numValues) override
+        {
+            state->observer->onNextBatch(values, numValues);
+        }
+
+        void onError(std::exception_ptr error) override
+        {
+            state->observer->onError(error);
+            state->subscription->unsubscribe();
+        }
+
+        void onCompleted() override
+        {
+            pushEndChildSubscription(state->subscription, childSubscription, teardownId);
+            state->subscribeToNext();
+        }
+
+    private:
+        const typename State::Ptr state;
+        const PushSubscription::Ptr childSubscription;
+        const PushSubscription::TeardownId teardownId;
+    };
+
+    const std::vector<typename PushSource<T>::Ptr> upstreams;
+};
+
+/**
+ Merges a changing set of upstream sources into one subject. Sources can be added and removed at any time, without resubscribing to the others.
+
+ The sources are kept in a table of slots. A handle is the slot index plus a generation count, so adding and removing a source takes constant time, freed slots are reused, and a stale handle (for a source that has already been removed) is ignored.
+
+ A source is removed when it completes. An error from a source is forwarded, and ends the hub (like terminate). Calls to the subject are serialized, so the sources may emit on different threads.
+ */
+template<typename T>
+class PushMergeHub : public juce::ReferenceCountedObject
+{
+public:
+    typedef juce::ReferenceCountedObjectPtr<PushMergeHub> Ptr;
+    typedef juce::uint64 Handle;
+
+    PushMergeHub()
+    : subject(new PushSubject<T>())
+    {}
+
+    typename PushSource<T>::Ptr getSource() const
+    {
+        return subject.get();
+    }
+
+    // Subscribes to the source, and returns a handle for removing it. Does nothing (and returns an invalid handle) if the hub has terminated.
+    Handle add(const typename PushSource<T>::Ptr& source)
+    {
+        const PushSubscription::Ptr subscription(new PushSubscription());
+        Handle handle;
+
+        {
+            const juce::ScopedLock lock(slotsLock);
+
+            if (terminated)
+                return 0;
+
+            size_t index;
+
+            if (freeSlots.empty()) {
+                index = slots.size();
+                slots.emplace_back();
+            }
+            else {
+                index = freeSlots.back();
+                freeSlots.pop_back();
+            }
+
+            Slot& slot = slots[index];
+            slot.subscription = subscription;
+            numSources++;
+
+            // Generations start at 1, so 0 is never a valid handle
+            handle = (static_cast<Handle>(++slot.generation) << 32) | static_cast<Handle>(index);
+        }
+
+        source->subscribe(new HubObserver(this, handle), subscription);
+
+        return handle;
+    }
+
+    // Unsubscribes from the source with the given handle. Does nothing if it has already been removed.
+    void remove(Handle handle)
+    {
+        PushSubscription::Ptr subscription;
+
+        {
+            const juce::ScopedLock lock(slotsLock);
+            const size_t index = static_cast<size_t>(handle & 0xffffffff);
+
+            if (index >= slots.size() || slots[index].generation != static_cast<juce::uint32>(handle >> 32) || slots[index].subscription == nullptr)
+                return;
+
+            subscription = std::move(slots[index].subscription);
+            slots[index].subscription = nullptr;
+            freeSlots.push_back(index);
+            numSources--;
+        }
+
+        subscription->unsubscribe();
+    }
+
+    size_t getNumSources() const
+    {
+        const juce::ScopedLock lock(slotsLock);
+        return numSources;
+    }
+
+    // Unsubscribes from all sources, and notifies the subject's observers. Adding sources afterwards does nothing.
+    void terminate(bool isError, std::exception_ptr error)
+    {
+        std::vector<Slot> toUnsubscribe;
+
+        {
+            const juce::ScopedLock lock(slotsLock);
+
+            if (terminated)
+                return;
+
+            terminated = true;
+            toUnsubscribe.swap(slots);
+            freeSlots.clear();
+            numSources = 0;
+        }
+
+        for (auto& slot : toUnsubscribe) {
+            if (slot.subscription != nullptr)
+                slot.subscription->unsubscribe();
+        }
+
+        const juce::ScopedLock lock(emitLock);
+
+        if (isError)
+            subject->onError(error);
+        else
+            subject->onCompleted();
+    }
+
+private:
+    struct Slot
+    {
+        PushSubscription::Ptr subscription;
+        juce::uint32 generation = 0;
+    };
+
+    class HubObserver : public PushObserver<T>
+    {
+    public:
+        HubObserver(const Ptr& hub, Handle handle)
+        : hub(hub),
+          handle(handle)
+        {}
+
+        void onNext(const T& value) override
+        {
+            const juce::ScopedLock lock(hub->emitLock);
+            hub->subject->onNext(value);
+        }
+
+        void onNextBatch(const T* values, size_t numValues) override
+        {
+            const juce::ScopedLock lock(hub->emitLock);
+            hub->subject->onNextBatch(values, numValues);
+        }
+
+        void onError(std::exception_ptr error) override
+        {
+            hub->terminate(true, error);
+        }
+
+        void onCompleted() override
+        {
+            hub->remove(handle);
+        }
+
+    private:
+        const Ptr hub;
+        const Handle handle;
+    };
+
+    const typename PushSubject<T>::Ptr subject;
+    juce::CriticalSection slotsLock;
+    juce::CriticalSection emitLock;
+    std::vector<Slot> slots;
+    std::vector<size_t> freeSlots;
+    size_t numSources = 0;
+    bool terminated = false;
+};
+
+
+#pragma mark - Flattening
+
+/**
+ For each upstream value, calls the function and subscribes to the returned inner source. The values from the inner sources are merged. Used for flatMap and concatMap.
+
+ If maxConcurrent is > 0, at most that many inner sources are subscribed to at the same time. Further upstream values are queued, and the function is only called when a slot becomes free. So work that starts on subscription is bounded. With maxConcurrent == 1, the inner sources are concatenated.
+
+ The queue is bounded with flow control: The upstream source may only emit maxConcurrent + prefetch values at first, and one more each time an inner source completes. Upstream sources that don't support flow control (like subjects) aren't slowed down, so their values are still queued.
+
+ It completes when the upstream source and all inner sources have completed. Calls to the observer are serialized.
+ */
+template<typename T, typename U>
+class PushFlatMapSource : public PushSource<U>
+{
+public:
+    typedef std::function<typename PushSource<U>::Ptr(const T&)> Function;
+
+    PushFlatMapSource(const typename PushSource<T>::Ptr& upstream, const Function& function, size_t maxConcurrent, size_t prefetch)
+    : upstream(upstream),
+      function(function),
+      maxConcurrent(maxConcurrent),
+      prefetch(prefetch)
+    {}
+
+    void subscribe(const typename PushObserver<U>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        const PushSubscription::Ptr outerSubscription = pushChildSubscription(subscription);
+
+        if (maxConcurrent > 0)
+            outerSubscription->limitDemand(static_cast<juce::int64>(maxConcurrent + prefetch));
+
+        const typename State::Ptr state(new State(function, maxConcurrent, observer, subscription, outerSubscription));
+        upstream->subscribe(new OuterObserver(state), outerSubscription);
+    }
+
+private:
+    class State : public juce::ReferenceCountedObject
+    {
+    public:
+        typedef juce::ReferenceCountedObjectPtr<State> Ptr;
+
+        State(const Function& function, size_t maxConcurrent, const typename PushObserver<U>::Ptr& observer, const PushSubscription::Ptr& subscription, const PushSubscription::Ptr& outerSubscription)
+        : function(function),
+          maxConcurrent(maxConcurrent),
+          observer(observer),
+          subscription(subscription),
+          outerSubscription(outerSubscription)
+        {}
+
+        void onOuterNext(const T& value)
+        {
+            outerSubscription->consume(1);
+
+            {
+                const juce::ScopedLock scopedLock(lock);
+
+                if (terminated)
+                    return;
+
+                pending.push_back(value);
+            }
+
+            drain();
+        }
+
+        void onOuterCompleted()
+        {
+            {
+                const juce::ScopedLock scopedLock(lock);
+                isOuterCompleted = true;
+            }
+
+            drain();
+        }
+
+        void onInnerNext(const U& value)
+        {
+            const juce::ScopedLock scopedLock(lock);
+
+            if (!terminated)
+                observer->onNext(value);
+        }
+
+        void onInnerNextBatch(const U* values, size_t numValues)
+        {
+            const juce::ScopedLock scopedLock(lock);
+
+            if (!terminated)
+                observer->onNextBatch(values, numValues);
+        }
+
+        void onInnerCompleted(const PushSubscription::Ptr& innerSubscription, PushSubscription::TeardownId teardownId)
+        {
+            pushEndChildSubscription(subscription, innerSubscription, teardownId);
+
+            {
+                const juce::ScopedLock scopedLock(lock);
+                numActive--;
+            }
+
+            // The free slot lets the upstream source emit another value
+            outerSubscription->request(1);
+            drain();
+        }
+
+        void onError(std::exception_ptr error)
+        {
+            {
+                const juce::ScopedLock scopedLock(lock);
+
+                if (terminated)
+                    return;
+
+                terminated = true;
+                observer->onError(error);
+            }
+
+            subscription->unsubscribe();
+        }
+
+    private:
+        const Function function;
+        const size_t maxConcurrent;
+        const typename PushObserver<U>::Ptr observer;
+        const PushSubscription::Ptr subscription;
+        const PushSubscription::Ptr outerSubscription;
+        juce::CriticalSection lock;
+        std::deque<T> pending;
+        size_t numActive = 0;
+        bool isOuterCompleted = false;
+        bool isDraining = false;
+        bool terminated = false;
+
+        // Subscribes to inner sources while there are free slots, and completes when everything has completed. If this is called while draining (because an inner source completed synchronously, or from another thread), the running loop picks up the change instead.
+        void drain()
+        {
+            {
+                const juce::ScopedLock scopedLock(lock);
+
+                if (isDraining)
+                    return;
+
+                isDraining = true;
+            }
+
+            for (;;) {
+                std::unique_ptr<T> value;
+
+                {
+                    const juce::ScopedLock scopedLock(lock);
+
+                    if (terminated || subscription->isUnsubscribed()) {
+                        isDraining = false;
+                        return;
+                    }
+
+                    if (!pending.empty() && (maxConcurrent == 0 || numActive < maxConcurrent)) {
+                        value.reset(new T(std::move(pending.front())));
+                        pending.pop_front();
+                        numActive++;
+                    }
+                    else if (isOuterCompleted && numActive == 0 && pending.empty()) {
+                        terminated = true;
+                        observer->onCompleted();
+                        return;
+                    }
+                    else {
+                        isDraining = false;
+                        return;
+                    }
+                }
+
+                typename PushSource<U>::Ptr inner;
+
+                try {
+                    inner = function(*value);
+                }
+                catch (...) {
+                    onError(std::current_exception());
+                    return;
+                }
+
+                PushSubscription::TeardownId teardownId = 0;
+                const PushSubscription::Ptr innerSubscription = pushChildSubscription(subscription, &teardownId);
+                inner->subscribe(new InnerObserver(this, innerSubscription, teardownId), innerSubscription);
+            }
+        }
+    };
+
+    class OuterObserver : public PushObserver<T>
+    {
+    public:
+        explicit OuterObserver(const typename State::Ptr& state)
+        : state(state)
+        {}
+
+        void onNext(const T& value) override
+        {
+            state->onOuterNext(value);
+        }
+
+        void onError(std::exception_ptr error) override
+        {
+            state->onError(error);
+        }
+
+        void onCompleted() override
+        {
+            state->onOuterCompleted();
+        }
+
+    private:
+        const typename State::Ptr state;
+    };
+
+    class InnerObserver : public PushObserver<U>
+    {
+    public:
+        InnerObserver(const typename State::Ptr& state, const PushSubscription::Ptr& subscription, PushSubscription::TeardownId teardownId)
+        : state(state),
+          subscription(subscription),
+          teardownId(teardownId)
+        {}
+
+        void onNext(const U& value) override
+        {
+            state->onInnerNext(value);
+        }
+
+        void onNextBatch(const U* values, size_t numValues) override
+        {
+            state->onInnerNextBatch(values, numValues);
+        }
+
+        void onError(std::exception_ptr error) override
+        {
+            state->onError(error);
+        }
+
+        void onCompleted() override
+        {
+            state->onInnerCompleted(subscription, teardownId);
+        }
+
+    private:
+        const typename State::Ptr state;
+        const PushSubscription::Ptr subscription;
+        const PushSubscription::TeardownId teardownId;
+    };
+
+    const typename PushSource<T>::Ptr upstream;
+    const Function function;
+    const size_t maxConcurrent;
+    const size_t prefetch;
+};
+
+/**
+ For each upstream value, calls the function and subscribes to the returned inner source, after unsubscribing from the previous one. So only the values from the latest inner source are emitted.
+
+ It completes when the upstream source and the latest inner source have completed. Calls to the observer are serialized.
+ */
+template<typename T, typename U>
+class PushSwitchMapSource : public PushSource<U>
+{
+public:
+    typedef std::function<typename PushSource<U>::Ptr(const T&)> Function;
+
+    PushSwitchMapSource(const typename PushSource<T>::Ptr& upstream, const Function& function)
+    : upstream(upstream),
+      function(function)
+    {}
+
+    void subscribe(const typename PushObserver<U>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        const typename State::Ptr state(new State(function, observer, subscription));
+        upstream->subscribe(new OuterObserver(state), pushChildSubscription(subscription));
+    }
+
+private:
+    class State : public juce::ReferenceCountedObject
+    {
+    public:
+        typedef juce::ReferenceCountedObjectPtr<State> Ptr;
+
+        State(const Function& function, const typename PushObserver<U>::Ptr& observer, const PushSubscription::Ptr& subscription)
+        : function(function),
+          observer(observer),
+          subscription(subscription)
+        {}
+
+        void onOuterNext(const T& value)
+        {
+            typename PushSource<U>::Ptr inner;
+
+            try {
+                inner = function(value);
+            }
+            catch (...) {
+                onError(std::current_exception());
+                return;
+            }
+
+            PushSubscription::TeardownId teardownId = 0;
+            const PushSubscription::Ptr innerSubscription = pushChildSubscription(subscription, &teardownId);
+            PushSubscription::Ptr previous;
+            PushSubscription::TeardownId previousTeardownId = 0;
+            juce::uint64 id;
+
+            {
+                const juce::ScopedLock scopedLock(lock);
+
+                if (terminated)
+                    return;
+
+                id = ++latestId;
+                previous = currentSubscription;
+                previousTeardownId = currentTeardownId;
+                currentSubscription = innerSubscription;
+                currentTeardownId = teardownId;
+                hasActiveInner = true;
+            }
+
+            if (previous != nullptr)
+                pushEndChildSubscription(subscription, previous, previousTeardownId);
+
+            inner->subscribe(new InnerObserver(this, id), innerSubscription);
+        }
+
+        void onOuterCompleted()
+        {
+            const juce::ScopedLock scopedLock(lock);
+            isOuterCompleted = true;
+
+            if (!hasActiveInner)
+                complete();
+        }
+
+        void onInnerNext(juce::uint64 id, const U& value)
+        {
+            const juce::ScopedLock scopedLock(lock);
+
+            if (id == latestId && !terminated)
+                observer->onNext(value);
+        }
+
+        void onInnerNextBatch(juce::uint64 id, const U* values, size_t numValues)
+        {
+            const juce::ScopedLock scopedLock(lock);
+
+            if (id == latestId && !terminated)
+                observer->onNextBatch(values, numValues);
+        }
+
+        void onInnerCompleted(juce::uint64 id)
+        {
+            PushSubscription::Ptr completed;
+            PushSubscription::TeardownId completedTeardownId = 0;
+
+            {
+                const juce::ScopedLock scopedLock(lock);
+
+                // An inner source that has been switched away from has been ended already
+                if (id != latestId)
+                    return;
+
+                hasActiveInner = false;
+                completed = currentSubscription;
+                currentSubscription = nullptr;
+                completedTeardownId = currentTeardownId;
+
+                if (isOuterCompleted)
+                    complete();
+            }
+
+            if (completed != nullptr)
+                pushEndChildSubscription(subscription, completed, completedTeardownId);
+        }
+
+        void onInnerError(juce::uint64 id, std::exception_ptr error)
+        {
+            {
+                const juce::ScopedLock scopedLock(lock);
+
+                // An error from an inner source that has been switched away from doesn't end the stream
+                if (id != latestId)
+                    return;
+            }
+
+            onError(error);
+        }
+
+        void onError(std::exception_ptr error)
+        {
+            {
+                const juce::ScopedLock scopedLock(lock);
+
+                if (terminated)
+                    return;
+
+                terminated = true;
+                observer->onError(error);
+            }
+
+            subscription->unsubscribe();
+        }
+
+    private:
+        const Function function;
+        const typename PushObserver<U>::Ptr observer;
+        const PushSubscription::Ptr subscription;
+        juce::CriticalSection lock;
+        PushSubscription::Ptr currentSubscription;
+        PushSubscription::TeardownId currentTeardownId = 0;
+        juce::uint64 latestId = 0;
+        bool hasActiveInner = false;
+        bool isOuterCompleted = false;
+        bool terminated = false;
+
+        void complete()
+        {
+            if (terminated)
+                return;
+
+            terminated = true;
+            observer->onCompleted();
+        }
+    };
+
+    class OuterObserver : public PushObserver<T>
+    {
+    public:
+        explicit OuterObserver(const typename State::Ptr& state)
+        : state(state)
+        {}
+
+        void onNext(const T& value) override
+        {
+            state->onOuterNext(value);
+        }
+
+        void onError(std::exception_ptr error) override
+        {
+            state->onError(error);
+        }
+
+        void onCompleted() override
+        {
+            state->onOuterCompleted();
+        }
+
+    private:
+        const typename State::Ptr state;
+    };
+
+    class InnerObserver : public PushObserver<U>
+    {
+    public:
+        InnerObserver(const typename State::Ptr& state, juce::uint64 id)
+        : state(state),
+          id(id)
+        {}
+
+        void onNext(const U& value) override
+        {
+            state->onInnerNext(id, value);
+        }
+
+        void onNextBatch(const U* values, size_t numValues) override
+        {
+            state->onInnerNextBatch(id, values, numValues);
+        }
+
+        void onError(std::exception_ptr error) override
+        {
+            state->onInnerError(id, error);
+        }
+
+        void onCompleted() override
+        {
+            state->onInnerCompleted(id);
+        }
+
+    private:
+        const typename State::Ptr state;
+        const juce::uint64 id;
+    };
+
+    const typename PushSource<T>::Ptr upstream;
+    const Function function;
+};
+
+
+#pragma mark - Scheduling
+
+// Runs actions on the thread(s) of a Scheduler, one after the other, in the order in which they were scheduled
+class PushWorker : public juce::ReferenceCountedObject
+{
+public:
+    typedef juce::ReferenceCountedObjectPtr<PushWorker> Ptr;
+
+    virtual void schedule(const std::function<void()>& action) = 0;
+
+    // Runs the action after the delay has passed
+    virtual void scheduleAfter(const juce::RelativeTime& delay, const std::function<void()>& action) = 0;
+
+    // Whether the calling thread is the one that runs the actions (or, for a pool, is running one of them). Used to avoid waiting for the worker on its own thread.
+    virtual bool isCurrentThread() const = 0;
+
+    // The current time in milliseconds, as used by scheduleAfter. Workers with a virtual clock return its time.
+    virtual double now() const
+    {
+        return juce::Time::getMillisecondCounterHiRes();
+    }
+
+    // Releases the worker's resources (like a dedicated thread). Actions that are scheduled afterwards are not run.
+    virtual void dispose() {}
+};
+
+// How a bounded queue handles a new value while it's full
+enum class PushOverflow {
+    Block,
+    DropOldest,
+    DropNewest,
+    Latest
+};
+
+/**
+ Emits the upstream values on a PushWorker, through a queue. The queue is drained by a single scheduled action, which emits the queued values as a batch. So a burst of values only schedules one action (and wakes up the worker's thread once). Values that arrive while a drain is emitting are emitted by the next drain, so each drain does a bounded amount of work.
+
+ A capacity of 0 means that the queue is unbounded. Otherwise, the queue requests `capacity` values from the upstream source, and requests another one for each value it emits or drops. So a producer that supports flow control (see PushSubscription::hasDemand) never overflows the queue. For other producers, the overflow strategy determines what happens:
+
+ Block: Waits until there's room in the queue. Values emitted on the worker's own thread (see PushWorker::isCurrentThread) are dropped instead, because waiting would deadlock.
+ DropOldest: Removes the oldest value from the queue.
+ DropNewest: Drops the new value.
+ Latest: Replaces the newest queued value with the new value. So the queue ends with the most recent value.
+
+ The values are emitted only while the downstream subscription has demand. So flow control continues downstream of the queue.
+ */
+template<typename T>
+class PushObserveOnSource : public PushSource<T>
+{
+public:
+    typedef std::function<PushWorker::Ptr()> CreateWorker;
+
+    PushObserveOnSource(const typename PushSource<T>::Ptr& upstream, const CreateWorker& createWorker, size_t capacity, PushOverflow overflow)
+    : upstream(upstream),
+      createWorker(createWorker),
+      capacity(capacity),
+      overflow(overflow)
+    {}
+
+    void subscribe(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        const PushWorker::Ptr worker = createWorker();
+        const PushSubscription::Ptr upstreamSubscription = pushChildSubscription(subscription);
+
+        if (capacity > 0)
+            upstreamSubscription->limitDemand(static_cast<juce::int64>(capacity));
+
+        const typename State::Ptr state(new State(observer, subscription, upstreamSubscription, worker, capacity, overflow));
+
+        subscription->setRequestHandler([state]() { state->scheduleDrain(); });
+        subscription->add([state, worker]() {
+            state->wakeUpBlockedProducer();
+            worker->dispose();
+        });
+
+        upstream->subscribe(new QueueObserver(state), upstreamSubscription);
+    }
+
+private:
+    class State : public juce::ReferenceCountedObject
+    {
+    public:
+        typedef juce::ReferenceCountedObjectPtr<State> Ptr;
+
+        State(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription, const PushSubscription::Ptr& upstreamSubscription, const PushWorker::Ptr& worker, size_t capacity, PushOverflow overflow)
+        : observer(observer),
+          subscription(subscription),
+          upstreamSubscription(upstreamSubscription),
+          worker(worker),
+          capacity(capacity),
+          overflow(overflow)
+        {}
+
+        void onNext(const T& value)
+        {
+            upstreamSubscription->consume(1);
+            bool takesNewSlot = true;
+            bool needsDrain = false;
+
+            {
+                const juce::ScopedLock scopedLock(lock);
+
+                while (capacity > 0 && queue.size() >= capacity && takesNewSlot) {
+                    switch (overflow) {
+                        case PushOverflow::Block:
+                            if (worker->isCurrentThread() || subscription->isUnsubscribed()) {
+                                takesNewSlot = false;
+                            }
+                            else {
+                                const juce::ScopedUnlock scopedUnlock(lock);
+                                spaceAvailable.wait(10);
+                            }
+                            break;
+                        case PushOverflow::DropOldest:
+                            queue.pop_front();
+                            queue.push_back(value);
+                            takesNewSlot = false;
+                            break;
+                        case PushOverflow::DropNewest:
+                            takesNewSlot = false;
+                            break;
+                        case PushOverflow::Latest:
+                            queue.back() = value;
+                            takesNewSlot = false;
+                            break;
+                    }
+                }
+
+                if (takesNewSlot)
+                    queue.push_back(value);
+
+                // Values that arrive while a drain is pending are picked up by that drain
+                needsDrain = (takesNewSlot && !isDrainScheduled);
+                isDrainScheduled = (isDrainScheduled || needsDrain);
+            }
+
+            if (needsDrain)
+                postDrain();
+
+            // A value that didn't take up a new slot gives back its unit of demand
+            if (!takesNewSlot)
+                upstreamSubscription->request(1);
+        }
+
+        void onTerminated(bool isError, std::exception_ptr error)
+        {
+            {
+                const juce::ScopedLock scopedLock(lock);
+                isTerminated = true;
+                terminationError = (isError ? error : std::exception_ptr());
+                hasError = isError;
+            }
+
+            scheduleDrain();
+        }
+
+        void scheduleDrain()
+        {
+            {
+                const juce::ScopedLock scopedLock(lock);
+
+                if (isDrainScheduled)
+                    return;
+
+                isDrainScheduled = true;
+            }
+
+            postDrain();
+        }
+
+        void wakeUpBlockedProducer()
+        {
+            spaceAvailable.signal();
+        }
+
+    private:
+        const typename PushObserver<T>::Ptr observer;
+        const PushSubscription::Ptr subscription;
+        const PushSubscription::Ptr upstreamSubscription;
+        const PushWorker::Ptr worker;
+        const size_t capacity;
+        const PushOverflow overflow;
+        juce::CriticalSection lock;
+        juce::WaitableEvent spaceAvailable;
+        std::deque<T> queue;
+        std::vector<T> batch;
+        bool isDrainScheduled = false;
+        bool isTerminated = false;
+        bool hasError = false;
+        std::exception_ptr terminationError;
+
+        void postDrain()
+        {
+            const Ptr self(this);
+            worker->schedule([self]() { self->drain(); });
+        }
+
+        // Emits the values that are queued when the drain starts (as far as the downstream subscription has demand), as one batch. Values that arrive during the emission are left for another drain, which is scheduled afterwards. So a fast producer can't keep a drain running, and the worker (like the message thread) gets to run its other actions in between. Only one drain runs at a time, so the batch storage can be reused.
+        void drain()
+        {
+            bool notifyTerminated = false;
+
+            {
+                const juce::ScopedLock scopedLock(lock);
+
+                if (subscription->isUnsubscribed()) {
+                    isDrainScheduled = false;
+                    return;
+                }
+
+                const size_t numToTake = static_cast<size_t>(juce::jlimit<juce::int64>(0, static_cast<juce::int64>(queue.size()), subscription->getDemand()));
+
+                if (numToTake > 0) {
+                    for (size_t i = 0; i < numToTake; i++) {
+                        batch.push_back(std::move(queue.front()));
+                        queue.pop_front();
+                    }
+                }
+                else if (queue.empty() && isTerminated) {
+                    notifyTerminated = true;
+                }
+                else {
+                    // Scheduled again when a value arrives, or when the downstream subscription requests more values
+                    isDrainScheduled = false;
+                    return;
+                }
+            }
+
+            if (notifyTerminated) {
+                if (hasError)
+                    observer->onError(terminationError);
+                else
+                    observer->onCompleted();
+
+                return;
+            }
+
+            if (overflow == PushOverflow::Block && capacity > 0)
+                spaceAvailable.signal();
+
+            upstreamSubscription->request(static_cast<juce::int64>(batch.size()));
+            observer->onNextBatch(batch.data(), batch.size());
+            batch.clear();
+
+            bool needsDrain;
+
+            {
+                const juce::ScopedLock scopedLock(lock);
+
+                needsDrain = !subscription->isUnsubscribed() && ((!queue.empty() && subscription->getDemand() > 0) || (queue.empty() && isTerminated));
+                isDrainScheduled = needsDrain;
+            }
+
+            if (needsDrain)
+                postDrain();
+        }
+    };
+
+    class QueueObserver : public PushObserver<T>
+    {
+    public:
+        explicit QueueObserver(const typename State::Ptr& state)
+        : state(state)
+        {}
+
+        void onNext(const T& value) override
+        {
+            state->onNext(value);
+        }
+
+        void onError(std::exception_ptr error) override
+        {
+            state->onTerminated(true, error);
+        }
+
+        void onCompleted() override
+        {
+            state->onTerminated(false, std::exception_ptr());
+        }
+
+    private:
+        const typename State::Ptr state;
+    };
+
+    const typename PushSource<T>::Ptr upstream;
+    const CreateWorker createWorker;
+    const size_t capacity;
+    const PushOverflow overflow;
+};
+
+/**
+ A slot that holds the latest value from one producer, for a consumer on another thread. The producer copies each value into spare storage outside the lock, so the lock is only held to swap pointers, never while T is copied or allocated.
+
+ The lock must be held for the calls marked as such. The others must be called without it.
+ */
+template<typename T>
+class PushLatestSlot
+{
+public:
+    // Stores a copy of the value, replacing the previous one. Calls to put must be serialized.
+    void put(juce::SpinLock& lock, const T& value)
+    {
+        std::unique_ptr<T> next;
+
+        {
+            const juce::SpinLock::ScopedLockType scopedLock(lock);
+            next = std::move(spare);
+        }
+
+        if (next != nullptr)
+            *next = value;
+        else
+            next.reset(new T(value));
+
+        {
+            const juce::SpinLock::ScopedLockType scopedLock(lock);
+            latest.swap(next);
+
+            // Keep the storage of the replaced value as the spare
+            if (spare == nullptr)
+                spare = std::move(next);
+        }
+
+        // If there's a spare already, the replaced value is destroyed here, outside the lock
+    }
+
+    // Must be called with the lock held
+    bool hasValue() const noexcept
+    {
+        return (latest != nullptr);
+    }
+
+    // Takes the value out of the slot. Must be called with the lock held.
+    std::unique_ptr<T> take() noexcept
+    {
+        return std::move(latest);
+    }
+
+    // Keeps the storage of a taken value for the next put. Must be called with the lock held. If there's a spare already, the storage is left in `storage`, to be destroyed outside the lock.
+    void recycle(std::unique_ptr<T>& storage) noexcept
+    {
+        if (spare == nullptr)
+            spare = std::move(storage);
+    }
+
+private:
+    std::unique_ptr<T> latest;
+    std::unique_ptr<T> spare;
+};
+
+/**
+ Emits the upstream values on a PushWorker, but only the latest one: Each value replaces the previous one in a single slot, and at most one action is scheduled at a time. So the worker runs at most one action per value it emits, however fast the upstream source is.
+
+ The slot storage is reused: The emitted value is moved out of the slot, and its storage is kept as a spare for the next value (see PushLatestSlot).
+ */
+template<typename T>
+class PushObserveOnLatestSource : public PushSource<T>
+{
+public:
+    typedef std::function<PushWorker::Ptr()> CreateWorker;
+
+    PushObserveOnLatestSource(const typename PushSource<T>::Ptr& upstream, const CreateWorker& createWorker)
+    : upstream(upstream),
+      createWorker(createWorker)
+    {}
+
+    void subscribe(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        const PushWorker::Ptr worker = createWorker();
+        const typename State::Ptr state(new State(observer, subscription, worker));
+
+        subscription->setRequestHandler([state]() { state->scheduleDispatch(); });
+        subscription->add([worker]() { worker->dispose(); });
+
+        // The slot never overflows, so the upstream subscription has unbounded demand
+        upstream->subscribe(new SlotObserver(state), pushChildSubscription(subscription));
+    }
+
+private:
+    class State : public juce::ReferenceCountedObject
+    {
+    public:
+        typedef juce::ReferenceCountedObjectPtr<State> Ptr;
+
+        State(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription, const PushWorker::Ptr& worker)
+        : observer(observer),
+          subscription(subscription),
+          worker(worker)
+        {}
+
+        void onNext(const T& value)
+        {
+            slot.put(lock, value);
+            scheduleDispatch();
+        }
+
+        void onTerminated(bool isError, std::exception_ptr error)
+        {
+            {
+                const juce::SpinLock::ScopedLockType scopedLock(lock);
+                isTerminated = true;
+                hasError = isError;
+                terminationError = error;
+            }
+
+            scheduleDispatch();
+        }
+
+        void scheduleDispatch()
+        {
+            {
+                const juce::SpinLock::ScopedLockType scopedLock(lock);
+
+                if (isDispatchScheduled)
+                    return;
+
+                isDispatchScheduled = true;
+            }
+
+            postDispatch();
+        }
+
+    private:
+        const typename PushObserver<T>::Ptr observer;
+        const PushSubscription::Ptr subscription;
+        const PushWorker::Ptr worker;
+        juce::SpinLock lock;
+        PushLatestSlot<T> slot;
+        bool isDispatchScheduled = false;
+        bool isTerminated = false;
+        bool hasNotifiedTermination = false;
+        bool hasError = false;
+        std::exception_ptr terminationError;
+
+        void postDispatch()
+        {
+            const Ptr self(this);
+            worker->schedule([self]() { self->dispatch(); });
+        }
+
+        // Whether there's a value (with demand for it) or a termination to emit. Must be called with the lock held.
+        bool hasWork() const
+        {
+            return ((slot.hasValue() && subscription->hasDemand()) || (isTerminated && !slot.hasValue() && !hasNotifiedTermination));
+        }
+
+        // Values that arrive while this is emitting don't schedule another dispatch. Afterwards, it checks the slot again, and schedules the next dispatch if needed. So only one dispatch runs at a time, even on a worker that may run actions in parallel.
+        void dispatch()
+        {
+            std::unique_ptr<T> value;
+            bool notifyTerminated = false;
+
+            {
+                const juce::SpinLock::ScopedLockType scopedLock(lock);
+
+                if (subscription->isUnsubscribed() || !hasWork()) {
+                    // Without demand, the value stays in the slot until the downstream subscription requests more
+                    isDispatchScheduled = false;
+                    return;
+                }
+
+                if (slot.hasValue() && subscription->hasDemand())
+                    value = slot.take();
+
+                notifyTerminated = (isTerminated && !slot.hasValue() && !hasNotifiedTermination);
+                hasNotifiedTermination = (hasNotifiedTermination || notifyTerminated);
+            }
+
+            if (value != nullptr)
+                observer->onNext(*value);
+
+            if (notifyTerminated) {
+                if (hasError)
+                    observer->onError(terminationError);
+                else
+                    observer->onCompleted();
+
+                return;
+            }
+
+            bool needsDispatch;
+
+            {
+                const juce::SpinLock::ScopedLockType scopedLock(lock);
+                slot.recycle(value);
+                needsDispatch = (!subscription->isUnsubscribed() && hasWork());
+                isDispatchScheduled = needsDispatch;
+            }
+
+            if (needsDispatch)
+                postDispatch();
+        }
+    };
+
+    class SlotObserver : public PushObserver<T>
+    {
+    public:
+        explicit SlotObserver(const typename State::Ptr& state)
+        : state(state)
+        {}
+
+        void onNext(const T& value) override
+        {
+            state->onNext(value);
+        }
+
+        void onError(std::exception_ptr error) override
+        {
+            state->onTerminated(true, error);
+        }
+
+        void onCompleted() override
+        {
+            state->onTerminated(false, std::exception_ptr());
+        }
+
+    private:
+        const typename State::Ptr state;
+    };
+
+    const typename PushSource<T>::Ptr upstream;
+    const CreateWorker createWorker;
+};
+
+
+// Schedules an action on the worker at an absolute time (as returned by PushWorker::now)
+inline void pushScheduleAt(const PushWorker::Ptr& worker, double time, const std::function<void()>& action)
+{
+    worker->scheduleAfter(juce::RelativeTime(juce::jmax(0.0, time - worker->now()) / 1000.0), action);
+}
+
+// Forwards the upstream notifications to the State of a time-based source
+template<typename T, typename State>
+class PushTimedObserver : public PushObserver<T>
+{
+public:
+    explicit PushTimedObserver(const typename State::Ptr& state)
+    : state(state)
+    {}
+
+    void onNext(const T& value) override
+    {
+        state->onNext(value);
+    }
+
+    void onError(std::exception_ptr error) override
+    {
+        state->onTerminated(true, error);
+    }
+
+    void onCompleted() override
+    {
+        state->onTerminated(false, std::exception_ptr());
+    }
+
+private:
+    const typename State::Ptr state;
+};
+
+/**
+ Emits 1, 2, 3, and so on, on a PushWorker: The first value right after subscribing, and then one value per period. The times are computed from the start time, so rounding errors don't add up.
+ */
+template<typename T>
+class PushIntervalSource : public PushSource<T>
+{
+public:
+    typedef std::function<PushWorker::Ptr()> CreateWorker;
+
+    PushIntervalSource(const juce::RelativeTime& period, const CreateWorker& createWorker)
+    : period(period.inSeconds() * 1000.0),
+      createWorker(createWorker)
+    {}
+
+    void subscribe(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        const PushWorker::Ptr worker = createWorker();
+        const typename State::Ptr state(new State(observer, subscription, worker, period));
+
+        subscription->add([worker]() { worker->dispose(); });
+        worker->schedule([state]() { state->tick(); });
+    }
+
+private:
+    class State : public juce::ReferenceCountedObject
+    {
+    public:
+        typedef juce::ReferenceCountedObjectPtr<State> Ptr;
+
+        State(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription, const PushWorker::Ptr& worker, double period)
+        : observer(observer),
+          subscription(subscription),
+          worker(worker),
+          period(period),
+          startTime(worker->now())
+        {}
+
+        void tick()
+        {
+            if (subscription->isUnsubscribed())
+                return;
+
+            observer->onNext(T(++count));
+
+            const Ptr self(this);
+            pushScheduleAt(worker, startTime + count * period, [self]() { self->tick(); });
+        }
+
+    private:
+        const typename PushObserver<T>::Ptr observer;
+        const PushSubscription::Ptr subscription;
+        const PushWorker::Ptr worker;
+        const double period;
+        const double startTime;
+        int count = 0;
+    };
+
+    const double period;
+    const CreateWorker createWorker;
+};
+
+/**
+ Emits the values from the upstream source on a PushWorker, but only once no new value has arrived for the given period.
+
+ It keeps at most one timer per subscription: When the timer fires early (because a value has arrived in the meantime), it's scheduled again for the remaining time. So a fast source doesn't schedule an action per value.
+
+ When the source completes, a pending value is emitted before onCompleted. An error is forwarded without emitting the pending value.
+ */
+template<typename T>
+class PushDebounceSource : public PushSource<T>
+{
+public:
+    typedef std::function<PushWorker::Ptr()> CreateWorker;
+
+    PushDebounceSource(const typename PushSource<T>::Ptr& upstream, const juce::RelativeTime& period, const CreateWorker& createWorker)
+    : upstream(upstream),
+      period(period.inSeconds() * 1000.0),
+      createWorker(createWorker)
+    {}
+
+    void subscribe(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        const PushWorker::Ptr worker = createWorker();
+        const typename State::Ptr state(new State(observer, subscription, worker, period));
+
+        subscription->add([worker]() { worker->dispose(); });
+        upstream->subscribe(new PushTimedObserver<T, State>(state), pushChildSubscription(subscription));
+    }
+
+private:
+    class State : public juce::ReferenceCountedObject
+    {
+    public:
+        typedef juce::ReferenceCountedObjectPtr<State> Ptr;
+
+        State(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription, const PushWorker::Ptr& worker, double period)
+        : observer(observer),
+          subscription(subscription),
+          worker(worker),
+          period(period)
+        {}
+
+        void onNext(const T& value)
+        {
+            const double newDueTime = worker->now() + period;
+            bool needsTimer = false;
+
+            // Move the due time first, so a timer that fires in between waits for the new value's period
+            {
+                const juce::SpinLock::ScopedLockType scopedLock(lock);
+                dueTime = newDueTime;
+                needsTimer = !isTimerScheduled;
+                isTimerScheduled = true;
+            }
+
+            slot.put(lock, value);
+
+            if (needsTimer)
+                scheduleTimer(newDueTime);
+        }
+
+        void onTerminated(bool isError, std::exception_ptr error)
+        {
+            const Ptr self(this);
+            worker->schedule([self, isError, error]() { self->terminate(isError, error); });
+        }
+
+    private:
+        const typename PushObserver<T>::Ptr observer;
+        const PushSubscription::Ptr subscription;
+        const PushWorker::Ptr worker;
+        const double period;
+        juce::SpinLock lock;
+        PushLatestSlot<T> slot;
+        double dueTime = 0;
+        bool isTimerScheduled = false;
+        bool isTerminated = false;
+
+        void scheduleTimer(double time)
+        {
+            const Ptr self(this);
+            pushScheduleAt(worker, time, [self]() { self->onTimer(); });
+        }
+
+        void onTimer()
+        {
+            const double now = worker->now();
+            std::unique_ptr<T> value;
+            bool needsTimer = false;
+            double nextDueTime = 0;
+
+            {
+                const juce::SpinLock::ScopedLockType scopedLock(lock);
+
+                if (isTerminated || subscription->isUnsubscribed())
+                    return;
+
+                // If a value has arrived since the timer was scheduled, wait for the rest of its period
+                needsTimer = (now < dueTime);
+                nextDueTime = dueTime;
+                isTimerScheduled = needsTimer;
+
+                if (!needsTimer)
+                    value = slot.take();
+            }
+
+            if (needsTimer) {
+                scheduleTimer(nextDueTime);
+            }
+            else if (value != nullptr) {
+                observer->onNext(*value);
+
+                // Keep the storage for the next value
+                const juce::SpinLock::ScopedLockType scopedLock(lock);
+                slot.recycle(value);
+            }
+        }
+
+        void terminate(bool isError, std::exception_ptr error)
+        {
+            std::unique_ptr<T> value;
+
+            {
+                const juce::SpinLock::ScopedLockType scopedLock(lock);
+
+                if (isTerminated || subscription->isUnsubscribed())
+                    return;
+
+                isTerminated = true;
+                value = slot.take();
+            }
+
+            if (isError) {
+                observer->onError(error);
+                return;
+            }
+
+            if (value != nullptr)
+                observer->onNext(*value);
+
+            observer->onCompleted();
+        }
+    };
+
+    const typename PushSource<T>::Ptr upstream;
+    const double period;
+    const CreateWorker createWorker;
+};
+
+/**
+ Emits the latest value from the upstream source once per period, on a PushWorker. Nothing is emitted for periods without a new value.
+
+ When the source terminates, the termination is forwarded on the worker. A value that hasn't been sampled yet is not emitted.
+ */
+template<typename T>
+class PushSampleSource : public PushSource<T>
+{
+public:
+    typedef std::function<PushWorker::Ptr()> CreateWorker;
+
+    PushSampleSource(const typename PushSource<T>::Ptr& upstream, const juce::RelativeTime& period, const CreateWorker& createWorker)
+    : upstream(upstream),
+      period(period.inSeconds() * 1000.0),
+      createWorker(createWorker)
+    {}
+
+    void subscribe(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        const PushWorker::Ptr worker = createWorker();
+        const typename State::Ptr state(new State(observer, subscription, worker, period));
+
+        subscription->add([worker]() { worker->dispose(); });
+        state->scheduleTick();
+        upstream->subscribe(new PushTimedObserver<T, State>(state), pushChildSubscription(subscription));
+    }
+
+private:
+    class State : public juce::ReferenceCountedObject
+    {
+    public:
+        typedef juce::ReferenceCountedObjectPtr<State> Ptr;
+
+        State(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription, const PushWorker::Ptr& worker, double period)
+        : observer(observer),
+          subscription(subscription),
+          worker(worker),
+          period(period),
+          startTime(worker->now())
+        {}
+
+        void onNext(const T& value)
+        {
+            slot.put(lock, value);
+        }
+
+        void onTerminated(bool isError, std::exception_ptr error)
+        {
+            const Ptr self(this);
+            worker->schedule([self, isError, error]() { self->terminate(isError, error); });
+        }
+
+        void scheduleTick()
+        {
+            const Ptr self(this);
+            pushScheduleAt(worker, startTime + (numTicks + 1) * period, [self]() { self->tick(); });
+        }
+
+    private:
+        const typename PushObserver<T>::Ptr observer;
+        const PushSubscription::Ptr subscription;
+        const PushWorker::Ptr worker;
+        const double period;
+        const double startTime;
+        juce::SpinLock lock;
+        PushLatestSlot<T> slot;
+        int numTicks = 0;
+        bool isTerminated = false;
+
+        void tick()
+        {
+            std::unique_ptr<T> value;
+
+            {
+                const juce::SpinLock::ScopedLockType scopedLock(lock);
+
+                if (isTerminated || subscription->isUnsubscribed())
+                    return;
+
+                value = slot.take();
+            }
+
+            if (value != nullptr) {
+                observer->onNext(*value);
+
+                // Keep the storage for the next value
+                const juce::SpinLock::ScopedLockType scopedLock(lock);
+                slot.recycle(value);
+            }
+
+            numTicks++;
+            scheduleTick();
+        }
+
+        void terminate(bool isError, std::exception_ptr error)
+        {
+            {
+                const juce::SpinLock::ScopedLockType scopedLock(lock);
+
+                if (isTerminated || subscription->isUnsubscribed())
+                    return;
+
+                isTerminated = true;
+            }
+
+            if (isError)
+                observer->onError(error);
+            else
+                observer->onCompleted();
+        }
+    };
+
+    const typename PushSource<T>::Ptr upstream;
+    const double period;
+    const CreateWorker createWorker;
+};
+
+#pragma mark - Multicasting
+
+/**
+ A source that shares a single subscription to an upstream source between all of its observers (like a connectable observable in rxcpp). Observers only receive values while it's connected.
+
+ The upstream source emits into a PushSubject, which remembers the last `bufferSize` values for new observers. When the upstream source terminates, the subject is replaced, so the next connection starts from scratch. If the connection is unsubscribed, the subject is kept (including its buffer), and the next connection continues to emit into it.
+ */
+template<typename T>
+class PushConnectable : public PushSource<T>
+{
+public:
+    typedef juce::ReferenceCountedObjectPtr<PushConnectable> Ptr;
+
+    PushConnectable(const typename PushSource<T>::Ptr& upstream, size_t bufferSize)
+    : upstream(upstream),
+      bufferSize(bufferSize),
+      subject(new PushSubject<T>(bufferSize))
+    {}
+
+    void subscribe(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        getSubject()->subscribe(observer, subscription);
+    }
+
+    // Subscribes to the upstream source, unless it's already connected. Returns the connection, which disconnects when it's unsubscribed.
+    PushSubscription::Ptr connect()
+    {
+        PushSubscription::Ptr newConnection;
+        typename PushSubject<T>::Ptr currentSubject;
+
+        {
+            const juce::ScopedLock lock(connectionLock);
+
+            if (connection != nullptr)
+                return connection;
+
+            newConnection = new PushSubscription();
+            connection = newConnection;
+            currentSubject = subject;
+        }
+
+        const Ptr self(this);
+        PushSubscription* const ended = newConnection.get();
+        newConnection->add([self, ended]() { self->disconnected(ended); });
+
+        upstream->subscribe(new ConnectionObserver(currentSubject, newConnection), newConnection);
+
+        return newConnection;
+    }
+
+private:
+    // Pushes the upstream values into the subject, and ends the connection when the upstream source terminates
+    class ConnectionObserver : public PushSubjectObserver<T>
+    {
+    public:
+        ConnectionObserver(const typename PushSubject<T>::Ptr& subject, const PushSubscription::Ptr& connection)
+        : PushSubjectObserver<T>(subject),
+          connection(connection)
+        {}
+
+        void onError(std::exception_ptr error) override
+        {
+            PushSubjectObserver<T>::onError(error);
+            connection->unsubscribe();
+        }
+
+        void onCompleted() override
+        {
+            PushSubjectObserver<T>::onCompleted();
+            connection->unsubscribe();
+        }
+
+    private:
+        const PushSubscription::Ptr connection;
+    };
+
+    const typename PushSource<T>::Ptr upstream;
+    const size_t bufferSize;
+    juce::CriticalSection connectionLock;
+    typename PushSubject<T>::Ptr subject;
+    PushSubscription::Ptr connection;
+
+    typename PushSubject<T>::Ptr getSubject() const
+    {
+        const juce::ScopedLock lock(connectionLock);
+        return subject;
+    }
+
+    void disconnected(PushSubscription* ended)
+    {
+        const juce::ScopedLock lock(connectionLock);
+
+        if (connection.get() != ended)
+            return;
+
+        connection = nullptr;
+
+        if (subject->isTerminated())
+            subject = new PushSubject<T>(bufferSize);
+    }
+};
+
+// Connects a PushConnectable when the first observer subscribes, and disconnects it when the last observer unsubscribes
+template<typename T>
+class PushRefCountSource : public PushSource<T>
+{
+public:
+    typedef juce::ReferenceCountedObjectPtr<PushRefCountSource> Ptr;
+
+    explicit PushRefCountSource(const typename PushConnectable<T>::Ptr& connectable)
+    : connectable(connectable)
+    {}
+
+    void subscribe(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        {
+            // Connecting and disconnecting are serialized, so a new observer never joins a connection that is about to end
+            const juce::ScopedLock lock(connectionLock);
+            connectable->subscribe(observer, subscription);
+
+            if (numObservers++ == 0)
+                connection = connectable->connect();
+        }
+
+        const Ptr self(this);
+        subscription->add([self]() { self->release(); });
+    }
+
+private:
+    const typename PushConnectable<T>::Ptr connectable;
+    juce::CriticalSection connectionLock;
+    PushSubscription::Ptr connection;
+    int numObservers = 0;
+
+    void release()
+    {
+        const juce::ScopedLock lock(connectionLock);
+
+        if (--numObservers > 0)
+            return;
+
+        const PushSubscription::Ptr toDisconnect(connection);
+        connection = nullptr;
+
+        if (toDisconnect != nullptr)
+            toDisconnect->unsubscribe();
+    }
+};
+
+
+#pragma mark - Subscribing
+
+/**
+ The observer at the end of a subscribed chain. It calls the user's functions, and unsubscribes after onError or onCompleted.
+
+ Values are ignored after unsubscribing. If onNext throws, the subscription is unsubscribed and the exception is passed on, like in rxcpp.
+
+ If it has a `nextBatch` function, batches are passed to it as a whole, and single values as batches of one.
+ */
+template<typename T>
+class PushFunctionObserver : public PushObserver<T>
+{
+public:
+    PushFunctionObserver(const PushSubscription::Ptr& subscription,
+                         const std::function<void(const T&)>& next,
+                         const std::function<void(std::exception_ptr)>& error,
+                         const std::function<void()>& completed,
+                         const std::function<void(const T*, size_t)>& nextBatch = nullptr)
+    : subscription(subscription),
+      next(next),
+      error(error),
+      completed(completed),
+      nextBatch(nextBatch)
+    {}
+
+    void onNext(const T& value) override
+    {
+        if (subscription->isUnsubscribed())
+            return;
+
+        try {
+            if (nextBatch)
+                nextBatch(&value, 1);
+            else
+                next(value);
+        }
+        catch (...) {
+            subscription->unsubscribe();
+            throw;
+        }
+    }
+
+    void onNextBatch(const T* values, size_t numValues) override
+    {
+        if (!nextBatch) {
+            PushObserver<T>::onNextBatch(values, numValues);
+            return;
+        }
+
+        if (subscription->isUnsubscribed())
+            return;
+
+        try {
+            nextBatch(values, numValues);
+        }
+        catch (...) {
+            subscription->unsubscribe();
+            throw;
+        }
+    }
+
+    void onError(std::exception_ptr e) override
+    {
+        if (subscription->isUnsubscribed())
+            return;
+
+        subscription->unsubscribe();
+        error(e);
+    }
+
+    void onCompleted() override
+    {
+        if (subscription->isUnsubscribed())
+            return;
+
+        subscription->unsubscribe();
+        completed();
+    }
+
+private:
+    const PushSubscription::Ptr subscription;
+    const std::function<void(const T&)> next;
+    const std::function<void(std::exception_ptr)> error;
+    const std::function<void()> completed;
+    const std::function<void(const T*, size_t)> nextBatch;
+};
+
+// Subscribes to a source with the given functions, and returns the subscription
+template<typename T>
+PushSubscription::Ptr pushSubscribe(const typename PushSource<T>::Ptr& source,
+                                    const std::function<void(const T&)>& onNext,
+                                    const std::function<void(std::exception_ptr)>& onError,
+                                    const std::function<void()>& onCompleted)
+{
+    PushSubscription::Ptr subscription(new PushSubscription());
+    source->subscribe(new PushFunctionObserver<T>(subscription, onNext, onError, onCompleted), subscription);
+
+    return subscription;
+}
+
+// Subscribes to a source with limited demand: The source may only emit initialDemand values, until more are requested with PushSubscription::request
+template<typename T>
+PushSubscription::Ptr pushSubscribeWithDemand(const typename PushSource<T>::Ptr& source,
+                                              juce::int64 initialDemand,
+                                              const std::function<void(const T&)>& onNext,
+                                              const std::function<void(std::exception_ptr)>& onError,
+                                              const std::function<void()>& onCompleted)
+{
+    PushSubscription::Ptr subscription(new PushSubscription());
+    subscription->limitDemand(initialDemand);
+
+    // Not captured as a Ptr, because the subscription doesn't own the observer
+    PushSubscription* const rawSubscription = subscription.get();
+    const auto consumingOnNext = [rawSubscription, onNext](const T& value) {
+        rawSubscription->consume(1);
+        onNext(value);
+    };
+
+    source->subscribe(new PushFunctionObserver<T>(subscription, consumingOnNext, onError, onCompleted), subscription);
+
+    return subscription;
+}
+
+// Subscribes to a source with a function that receives whole batches, and returns the subscription
+template<typename T>
+PushSubscription::Ptr pushSubscribeBatches(const typename PushSource<T>::Ptr& source,
+                                           const std::function<void(const T*, size_t)>& onNextBatch,
+                                           const std::function<void(std::exception_ptr)>& onError,
+                                           const std::function<void()>& onCompleted)
+{
+    PushSubscription::Ptr subscription(new PushSubscription());
+    source->subscribe(new PushFunctionObserver<T>(subscription, nullptr, onError, onCompleted, onNextBatch), subscription);
+
+    return subscription;
+}
+
+// A PushObserver together with the lifetime of its subscription, so it can be wrapped in an ObserverImpl. The subscription is null if the observer isn't bound to a subscription (like the Observer side of a Subject).
+template<typename T>
+struct PushObserverHandle
+{
+    typename PushObserver<T>::Ptr observer;
+    PushSubscription::Ptr subscription;
+
+    bool operator==(const PushObserverHandle& other) const
+    {
+        return (observer == other.observer && subscription == other.subscription);
+    }
+};
+}
@@ -1,5 +1,47 @@
 namespace detail {
-SchedulerImpl::SchedulerImpl(const Schedule& schedule)
-: schedule(schedule)
+SchedulerImpl::SchedulerImpl(const CreateWorker& createWorker)
+: createWorker(createWorker)
 {}
+
+double VirtualClock::getNow() const
+{
+    const ScopedLock lock(criticalSection);
+    return now;
+}
+
+void VirtualClock::schedule(double dueTime, const Action& action)
+{
+    const ScopedLock lock(criticalSection);
+    actions.emplace(jmax(now, dueTime), action);
+}
+
+void VirtualClock::advanceBy(double milliseconds)
+{
+    double endTime;
+
+    {
+        const ScopedLock lock(criticalSection);
+        endTime = now + jmax(0.0, milliseconds);
+    }
+
+    // Actions may schedule new actions. Those run in this call too, if they are due before endTime.
+    for (;;) {
+        Action action;
+
+        {
+            const ScopedLock lock(criticalSection);
+
+            if (actions.empty() || actions.begin()->first > endTime) {
+                now = jmax(now, endTime);
+                return;
+            }
+
+            now = jmax(now, actions.begin()->first);
+            action = std::move(actions.begin()->second);
+            actions.erase(actions.begin());
+        }
+
+        action();
+    }
+}
 }
@@ -3,10 +3,92 @@
 namespace detail {
 struct SchedulerImpl
 {
-    typedef std::function<rxcpp::observable<any>(const rxcpp::observable<any>&)> Schedule;
+    typedef std::function<PushWorker::Ptr()> CreateWorker;
 
-    SchedulerImpl(const Schedule& schedule);
+    SchedulerImpl(const CreateWorker& createWorker);
 
-    const Schedule schedule;
+    // Creates a worker for each subscription to an Observable that is observed on the scheduler
+    const CreateWorker createWorker;
+};
+
+// Checks a DrainBudget during a callback, and counts DrainMetrics. The budget can be changed, and the metrics can be read, on any thread.
+class DrainMeter
+{
+public:
+    void setBudget(const DrainBudget& budget)
+    {
+        maxItems = budget.maxItems;
+        maxMilliseconds = budget.maxDuration.inSeconds() * 1000.0;
+    }
+
+    void beginCallback()
+    {
+        callbackStartTime = juce::Time::getMillisecondCounterHiRes();
+        numItemsInCallback = 0;
+        ++numCallbacks;
+    }
+
+    // The number of items that may still be processed in this callback
+    int getRemainingItems() const
+    {
+        const int limit = maxItems.get();
+        return (limit > 0 ? juce::jmax(0, limit - numItemsInCallback) : std::numeric_limits<int>::max());
+    }
+
+    void addItems(int numItems)
+    {
+        numItemsInCallback += numItems;
+        totalItems += numItems;
+    }
+
+    // Whether the caller should stop, and continue in the next callback
+    bool isExhausted() const
+    {
+        const double maxTime = maxMilliseconds.get();
+        return (getRemainingItems() == 0 || (maxTime > 0 && juce::Time::getMillisecondCounterHiRes() - callbackStartTime >= maxTime));
+    }
+
+    // Call this when stopping with work left, because the budget is used up
+    void recordExhausted()
+    {
+        ++numBudgetExhausted;
+    }
+
+    DrainMetrics getMetrics() const
+    {
+        DrainMetrics metrics;
+        metrics.numCallbacks = numCallbacks.get();
+        metrics.numItems = totalItems.get();
+        metrics.numBudgetExhausted = numBudgetExhausted.get();
+        return metrics;
+    }
+
+private:
+    juce::Atomic<int> maxItems;
+    juce::Atomic<double> maxMilliseconds;
+    juce::Atomic<juce::int64> numCallbacks;
+    juce::Atomic<juce::int64> totalItems;
+    juce::Atomic<juce::int64> numBudgetExhausted;
+    double callbackStartTime = 0;
+    int numItemsInCallback = 0;
+};
+
+// The clock of a VirtualTimeScheduler. Time only passes in advanceBy, which runs the actions that are due, in the order of their due times. Actions with the same due time run in the order in which they were scheduled.
+class VirtualClock
+{
+public:
+    typedef std::function<void()> Action;
+
+    // In milliseconds since the clock was created
+    double getNow() const;
+
+    void schedule(double dueTime, const Action& action);
+
+    void advanceBy(double milliseconds);
+
+private:
+    juce::CriticalSection criticalSection;
+    double now = 0;
+    std::multimap<double, Action> actions;
 };
 }
@@ -0,0 +1,340 @@
+#pragma once
+
+namespace detail {
+// Gives the simd operators access to the PushSource of a TypedObservable
+struct TypedObservableAccess
+{
+    template<typename T>
+    static typename PushSource<T>::Ptr getSource(const TypedObservable<T>& observable)
+    {
+        return observable.source;
+    }
+
+    template<typename T>
+    static TypedObservable<T> create(const typename PushSource<T>::Ptr& source)
+    {
+        return TypedObservable<T>(source);
+    }
+};
+
+namespace kernels {
+// Kernels for contiguous spans. The generic versions are scalar loops. The float and double overloads use juce::FloatVectorOperations, which use SSE or NEON where available.
+
+template<typename T>
+void affine(T* dest, const T* source, size_t numValues, T multiplier, T offset)
+{
+    for (size_t i = 0; i < numValues; i++)
+        dest[i] = source[i] * multiplier + offset;
+}
+
+template<typename T>
+void affineVectorized(T* dest, const T* source, size_t numValues, T multiplier, T offset)
+{
+    juce::FloatVectorOperations::copyWithMultiply(dest, source, multiplier, static_cast<int>(numValues));
+
+    if (offset != T())
+        juce::FloatVectorOperations::add(dest, offset, static_cast<int>(numValues));
+}
+
+inline void affine(float* dest, const float* source, size_t numValues, float multiplier, float offset)
+{
+    affineVectorized(dest, source, numValues, multiplier, offset);
+}
+
+inline void affine(double* dest, const double* source, size_t numValues, double multiplier, double offset)
+{
+    affineVectorized(dest, source, numValues, multiplier, offset);
+}
+
+// numValues must be > 0
+template<typename T>
+T minimum(const T* values, size_t numValues)
+{
+    return *std::min_element(values, values + numValues);
+}
+
+inline float minimum(const float* values, size_t numValues)
+{
+    return juce::FloatVectorOperations::findMinimum(values, static_cast<int>(numValues));
+}
+
+inline double minimum(const double* values, size_t numValues)
+{
+    return juce::FloatVectorOperations::findMinimum(values, static_cast<int>(numValues));
+}
+
+// numValues must be > 0
+template<typename T>
+T maximum(const T* values, size_t numValues)
+{
+    return *std::max_element(values, values + numValues);
+}
+
+inline float maximum(const float* values, size_t numValues)
+{
+    return juce::FloatVectorOperations::findMaximum(values, static_cast<int>(numValues));
+}
+
+inline double maximum(const double* values, size_t numValues)
+{
+    return juce::FloatVectorOperations::findMaximum(values, static_cast<int>(numValues));
+}
+
+// The largest absolute value. numValues must be > 0.
+template<typename T>
+T peak(const T* values, size_t numValues)
+{
+    return juce::jmax(-minimum(values, numValues), maximum(values, numValues));
+}
+
+inline float peak(const float* values, size_t numValues)
+{
+    const auto range = juce::FloatVectorOperations::findMinAndMax(values, static_cast<int>(numValues));
+    return juce::jmax(-range.getStart(), range.getEnd());
+}
+
+inline double peak(const double* values, size_t numValues)
+{
+    const auto range = juce::FloatVectorOperations::findMinAndMax(values, static_cast<int>(numValues));
+    return juce::jmax(-range.getStart(), range.getEnd());
+}
+
+// Uses 4 independent partial sums, so the compiler can vectorize the loop (and the additions don't wait for each other).
+template<typename T, typename Transform>
+T sum(const T* values, size_t numValues, Transform transform)
+{
+    T partialSums[4] = {};
+    size_t i = 0;
+
+    for (; i + 4 <= numValues; i += 4) {
+        partialSums[0] += transform(values[i]);
+        partialSums[1] += transform(values[i + 1]);
+        partialSums[2] += transform(values[i + 2]);
+        partialSums[3] += transform(values[i + 3]);
+    }
+
+    for (; i < numValues; i++)
+        partialSums[0] += transform(values[i]);
+
+    return (partialSums[0] + partialSums[1]) + (partialSums[2] + partialSums[3]);
+}
+
+template<typename T>
+T sum(const T* values, size_t numValues)
+{
+    return sum(values, numValues, [](T value) { return value; });
+}
+
+template<typename T>
+T sumOfSquares(const T* values, size_t numValues)
+{
+    return sum(values, numValues, [](T value) { return value * value; });
+}
+
+// Writes the running sum to dest, and returns the last one. Each sum depends on the previous one, so this is always a scalar loop.
+template<typename T>
+T runningSum(T* dest, const T* source, size_t numValues, T startValue)
+{
+    T accumulator = startValue;
+
+    for (size_t i = 0; i < numValues; i++) {
+        accumulator += source[i];
+        dest[i] = accumulator;
+    }
+
+    return accumulator;
+}
+}
+
+// Applies value * multiplier + offset to each value
+template<typename T>
+class SimdAffineObserver : public PushForwardingObserver<T>
+{
+public:
+    SimdAffineObserver(const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription, T multiplier, T offset)
+    : PushForwardingObserver<T>(downstream, subscription),
+      multiplier(multiplier),
+      offset(offset)
+    {}
+
+    void onNext(const T& value) override
+    {
+        if (!this->hasEnded())
+            this->downstream->onNext(value * multiplier + offset);
+    }
+
+    void onNextBatch(const T* values, size_t numValues) override
+    {
+        if (numValues == 0 || this->hasEnded())
+            return;
+
+        // Take the storage, in case the downstream observer emits into this one again
+        juce::Array<T> results(std::move(storage));
+        results.resize(static_cast<int>(numValues));
+
+        kernels::affine(results.begin(), values, numValues, multiplier, offset);
+        this->downstream->onNextBatch(results.begin(), numValues);
+
+        storage = std::move(results);
+    }
+
+private:
+    const T multiplier;
+    const T offset;
+    juce::Array<T> storage;
+};
+
+template<typename T>
+class SimdRunningSumObserver : public PushForwardingObserver<T>
+{
+public:
+    SimdRunningSumObserver(const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription, T startValue)
+    : PushForwardingObserver<T>(downstream, subscription),
+      accumulator(startValue)
+    {}
+
+    void onNext(const T& value) override
+    {
+        if (this->hasEnded())
+            return;
+
+        accumulator += value;
+        this->downstream->onNext(accumulator);
+    }
+
+    void onNextBatch(const T* values, size_t numValues) override
+    {
+        if (numValues == 0 || this->hasEnded())
+            return;
+
+        juce::Array<T> results(std::move(storage));
+        results.resize(static_cast<int>(numValues));
+
+        accumulator = kernels::runningSum(results.begin(), values, numValues, accumulator);
+        this->downstream->onNextBatch(results.begin(), numValues);
+
+        storage = std::move(results);
+    }
+
+private:
+    T accumulator;
+    juce::Array<T> storage;
+};
+
+// Aggregates all values, and emits the result when the source completes
+template<typename T>
+class SimdReduceObserver : public PushForwardingObserver<T>
+{
+public:
+    enum class Kind {
+        Sum,
+        Minimum,
+        Maximum
+    };
+
+    SimdReduceObserver(const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription, Kind kind)
+    : PushForwardingObserver<T>(downstream, subscription),
+      kind(kind)
+    {}
+
+    void onNext(const T& value) override
+    {
+        onNextBatch(&value, 1);
+    }
+
+    void onNextBatch(const T* values, size_t numValues) override
+    {
+        if (numValues == 0 || this->hasEnded())
+            return;
+
+        switch (kind) {
+            case Kind::Sum:
+                result += kernels::sum(values, numValues);
+                break;
+            case Kind::Minimum: {
+                const T batchMinimum = kernels::minimum(values, numValues);
+                result = (hasValues ? juce::jmin(result, batchMinimum) : batchMinimum);
+                break;
+            }
+            case Kind::Maximum: {
+                const T batchMaximum = kernels::maximum(values, numValues);
+                result = (hasValues ? juce::jmax(result, batchMaximum) : batchMaximum);
+                break;
+            }
+        }
+
+        hasValues = true;
+    }
+
+    void onCompleted() override
+    {
+        // The sum of no values is 0, but there's no minimum or maximum
+        if (hasValues || kind == Kind::Sum)
+            this->downstream->onNext(result);
+
+        this->downstream->onCompleted();
+    }
+
+private:
+    const Kind kind;
+    T result = T();
+    bool hasValues = false;
+};
+
+// Emits one value per window of `windowSize` values: its peak (the largest absolute value) or its RMS. The windows don't depend on how the values are batched: A window may span several batches, and a batch may contain several windows.
+template<typename T>
+class SimdLevelObserver : public PushForwardingObserver<T>
+{
+public:
+    enum class Kind {
+        Peak,
+        RMS
+    };
+
+    SimdLevelObserver(const typename PushObserver<T>::Ptr& downstream, const PushSubscription::Ptr& subscription, Kind kind, size_t windowSize)
+    : PushForwardingObserver<T>(downstream, subscription),
+      kind(kind),
+      windowSize(windowSize)
+    {}
+
+    void onNext(const T& value) override
+    {
+        onNextBatch(&value, 1);
+    }
+
+    void onNextBatch(const T* values, size_t numValues) override
+    {
+        while (numValues > 0 && !this->hasEnded()) {
+            const size_t numToAdd = juce::jmin(numValues, windowSize - numInWindow);
+
+            if (kind == Kind::Peak)
+                accumulated = juce::jmax(accumulated, kernels::peak(values, numToAdd));
+            else
+                accumulated += kernels::sumOfSquares(values, numToAdd);
+
+            numInWindow += numToAdd;
+            values += numToAdd;
+            numValues -= numToAdd;
+
+            if (numInWindow == windowSize) {
+                const T level = (kind == Kind::Peak ? accumulated : std::sqrt(accumulated / static_cast<T>(windowSize)));
+                accumulated = 0;
+                numInWindow = 0;
+                this->downstream->onNext(level);
+            }
+        }
+    }
+
+private:
+    const Kind kind;
+    const size_t windowSize;
+    size_t numInWindow = 0;
+    T accumulated = 0;
+};
+
+template<typename T, typename MakeObserver>
+TypedObservable<T> simdLift(const TypedObservable<T>& source, const MakeObserver& makeObserver)
+{
+    return TypedObservableAccess::create<T>(pushLift<T, T>(TypedObservableAccess::getSource(source), makeObserver));
+}
+}
@@ -1,32 +1,36 @@
 namespace {
-template<typename SubjectType, typename... Args>
-detail::SubjectImpl MakeSubjectImpl(Args&&... args)
+detail::SubjectImpl MakeSubjectImpl(const detail::PushSubject<any>::Ptr& subject)
 {
-    // Need to use shared_ptr here, so we can call get_subscriber() and get_observable() on the same instance that we store in the SubjectImpl.
-    auto subject = std::make_shared<SubjectType>(std::forward<Args>(args)...);
-    return detail::SubjectImpl(any(subject), any(subject->get_subscriber().as_dynamic()), any(subject->get_observable().as_dynamic()));
+    // The Observer side isn't bound to a subscription: It keeps pushing values into the subject as long as it exists.
+    const detail::PushObserverHandle<any> observer{ new detail::PushSubjectObserver<any>(subject), detail::PushSubscription::Ptr() };
+
+    return detail::SubjectImpl(any(subject), any(observer), any(detail::PushSource<any>::Ptr(subject.get())));
 }
 }
 
 namespace detail {
 SubjectImpl SubjectImpl::MakeBehaviorSubjectImpl(any&& initial)
 {
-    return MakeSubjectImpl<rxcpp::subjects::behavior<any>>(std::move(initial));
+    // Remembers the latest value, but doesn't emit it to Observers that subscribe after it has terminated (like in rxcpp)
+    PushSubject<any>::Ptr subject(new PushSubject<any>(1, false));
+    subject->onNext(initial);
+
+    return MakeSubjectImpl(subject);
 }
 
 SubjectImpl SubjectImpl::MakePublishSubjectImpl()
 {
-    return MakeSubjectImpl<rxcpp::subjects::subject<any>>();
+    return MakeSubjectImpl(new PushSubject<any>());
 }
 
 SubjectImpl SubjectImpl::MakeReplaySubjectImpl(size_t bufferSize)
 {
-    return MakeSubjectImpl<rxcpp::subjects::replay<any, rxcpp::identity_one_worker>>(bufferSize, rxcpp::identity_immediate());
+    return MakeSubjectImpl(new PushSubject<any>(bufferSize, true));
 }
 
 any SubjectImpl::getValue() const
 {
-    return wrapped.get<std::shared_ptr<rxcpp::subjects::behavior<any>>>()->get_value();
+    return wrapped.get<PushSubject<any>::Ptr>()->getLatestValue();
 }
 
 SubjectImpl::SubjectImpl(const any& subject, const any& observer, const any& observable)
@@ -0,0 +1,670 @@
+#pragma once
+
+namespace detail {
+// Lets the calling thread run on all CPU cores again, after an affinity mask has been applied
+inline void resetThreadAffinity()
+{
+#if JUCE_LINUX || JUCE_ANDROID
+    // Not limited to 32 cores, like the mask of juce::Thread::setCurrentThreadAffinityMask. Cores that don't exist are ignored.
+    cpu_set_t cores;
+    CPU_ZERO(&cores);
+
+    for (int i = 0; i < CPU_SETSIZE; i++)
+        CPU_SET(i, &cores);
+
+    sched_setaffinity(0, sizeof(cores), &cores);
+#else
+    const int numCores = juce::jlimit(1, 32, juce::SystemStats::getNumCpus());
+    juce::Thread::setCurrentThreadAffinityMask(numCores == 32 ? 0xFFFFFFFF : (juce::uint32(1) << numCores) - 1);
+#endif
+}
+
+// Applies the priority and CPU affinity to the calling thread. The affinity is only changed if a mask is set, or if the previous options have set one. Errors are ignored (e.g. if the process isn't allowed to raise the priority of a thread back to Normal), so the thread just keeps its current settings.
+inline void applyThreadOptions(const ThreadOptions& options, const ThreadOptions& previousOptions)
+{
+    if (options.affinityMask != 0)
+        juce::Thread::setCurrentThreadAffinityMask(options.affinityMask);
+    else if (previousOptions.affinityMask != 0)
+        resetThreadAffinity();
+
+#if JUCE_LINUX || JUCE_ANDROID
+    sched_param param;
+    param.sched_priority = 0;
+#ifdef SCHED_IDLE
+    const int idlePolicy = SCHED_IDLE;
+#else
+    const int idlePolicy = SCHED_OTHER;
+#endif
+    pthread_setschedparam(pthread_self(), (options.priority == ThreadPriority::Idle ? idlePolicy : SCHED_OTHER), &param);
+
+    // On Linux, the nice level applies to a single thread
+    const int niceLevel = (options.priority == ThreadPriority::Normal ? 0 : (options.priority == ThreadPriority::Low ? 10 : 19));
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), niceLevel);
+#elif JUCE_MAC || JUCE_IOS
+    const qos_class_t qosClasses[] = { QOS_CLASS_DEFAULT, QOS_CLASS_UTILITY, QOS_CLASS_BACKGROUND };
+    pthread_set_qos_class_self_np(qosClasses[static_cast<int>(options.priority)], 0);
+#else
+    // JUCE's priorities 0 and 3 map to THREAD_PRIORITY_IDLE and THREAD_PRIORITY_BELOW_NORMAL on Windows
+    const int priorities[] = { 5, 3, 0 };
+    juce::Thread::setCurrentThreadPriority(priorities[static_cast<int>(options.priority)]);
+#endif
+}
+
+/**
+ A fixed set of threads, each with its own deque of tasks. A thread takes tasks from its own deque first. When that is empty, it steals from the other deques, so the work spreads across all threads. Idle threads sleep until a task arrives.
+
+ Tasks submitted on a pool thread go to that thread's deque, other tasks are distributed round-robin. Timed tasks are kept in a separate list. Whenever a thread looks for a task, it moves the due timed tasks to its own deque. One idle thread at a time sleeps only until the earliest deadline, so a timed task isn't late just because the other threads are busy.
+
+ The threads are named and configured with ThreadOptions. The options can be changed while the threads are running: Each thread applies them when it's done with its current task.
+
+ The threads keep running while the pool is referenced, or until shutDown() is called. Pending tasks hold a reference to the pool (through their ThreadPoolWorker), so the pool is only destroyed when it's idle. If that happens on a pool thread, the thread is detached instead of joined.
+ */
+class ThreadPool : public juce::ReferenceCountedObject
+{
+public:
+    typedef juce::ReferenceCountedObjectPtr<ThreadPool> Ptr;
+    typedef std::function<void()> Task;
+
+    ThreadPool(int numThreads, const ThreadOptions& options)
+    : state(new State(juce::jmax(1, numThreads), options))
+    {
+        for (size_t i = 0; i < state->queues.size(); i++) {
+            const State::Ptr threadState(state);
+            threads.emplace_back([threadState, i]() { threadState->run(i); });
+            state->threadIds.push_back(threads.back().get_id());
+        }
+
+        state->hasStarted = 1;
+        getNumThreadsCreated() += static_cast<int>(threads.size());
+    }
+
+    ~ThreadPool()
+    {
+        shutDown();
+    }
+
+    // Stops the threads, and discards the tasks that haven't run yet. Tasks that are submitted afterwards are ignored.
+    void shutDown()
+    {
+        state->shutDown();
+
+        for (auto& thread : threads) {
+            if (!thread.joinable())
+                continue;
+
+            if (thread.get_id() == std::this_thread::get_id())
+                thread.detach();
+            else
+                thread.join();
+        }
+
+        state->discardTasks();
+    }
+
+    void submit(const Task& task)
+    {
+        state->submit(task);
+    }
+
+    void submitAfter(const juce::RelativeTime& delay, const Task& task)
+    {
+        state->submitAfter(delay, task);
+    }
+
+    void setOptions(const ThreadOptions& options)
+    {
+        state->setOptions(options);
+    }
+
+    bool isPoolThread() const
+    {
+        return (state->getCurrentThreadIndex() >= 0);
+    }
+
+    int getNumThreads() const
+    {
+        return static_cast<int>(threads.size());
+    }
+
+    // The number of threads that have been created by all ThreadPools so far
+    static juce::Atomic<int>& getNumThreadsCreated()
+    {
+        static juce::Atomic<int> numThreadsCreated;
+        return numThreadsCreated;
+    }
+
+private:
+    // Shared with the threads, because a detached thread may outlive the pool
+    struct State : public juce::ReferenceCountedObject
+    {
+        typedef juce::ReferenceCountedObjectPtr<State> Ptr;
+
+        struct Queue
+        {
+            juce::SpinLock lock;
+            std::deque<Task> tasks;
+            juce::WaitableEvent wakeUp;
+            juce::Atomic<int> isSleeping;
+        };
+
+        State(int numThreads, const ThreadOptions& options)
+        : queues(static_cast<size_t>(numThreads)),
+          options(options)
+        {
+            for (auto& queue : queues)
+                queue.reset(new Queue());
+        }
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread::id> threadIds;
+        juce::Atomic<int> hasStarted;
+        juce::Atomic<int> shouldExit;
+        juce::Atomic<juce::uint32> nextQueue;
+        juce::CriticalSection timedTasksLock;
+        std::multimap<double, Task> timedTasks;
+        juce::Atomic<int> numTimedTasks;
+        juce::Atomic<int> timerWaiter; // The index + 1 of the thread that waits for the next deadline, or 0
+        juce::SpinLock optionsLock;
+        ThreadOptions options;
+        juce::Atomic<int> optionsVersion;
+
+        void setOptions(const ThreadOptions& newOptions)
+        {
+            {
+                const juce::SpinLock::ScopedLockType lock(optionsLock);
+                options = newOptions;
+            }
+
+            ++optionsVersion;
+
+            // Sleeping threads apply them right away
+            for (auto& queue : queues)
+                queue->wakeUp.signal();
+        }
+
+        // Applies the current options to the thread with the given index. appliedOptions are the options that it has applied before.
+        void applyOptions(size_t index, ThreadOptions& appliedOptions)
+        {
+            ThreadOptions currentOptions;
+
+            {
+                const juce::SpinLock::ScopedLockType lock(optionsLock);
+                currentOptions = options;
+            }
+
+            juce::String name = (currentOptions.name.isEmpty() ? juce::String("ReaX") : currentOptions.name);
+            const juce::String suffix = (queues.size() > 1 ? " " + juce::String(index + 1) : juce::String());
+#if JUCE_LINUX || JUCE_ANDROID
+            // Longer names are rejected
+            const int maxNameLength = 15;
+            name = name.substring(0, maxNameLength - suffix.length());
+#endif
+            juce::Thread::setCurrentThreadName(name + suffix);
+            applyThreadOptions(currentOptions, appliedOptions);
+            appliedOptions = currentOptions;
+        }
+
+        void submit(const Task& task)
+        {
+            const int currentIndex = getCurrentThreadIndex();
+            const size_t index = (currentIndex >= 0 ? static_cast<size_t>(currentIndex) : (++nextQueue) % queues.size());
+            Queue& queue = *queues[index];
+
+            {
+                const juce::SpinLock::ScopedLockType lock(queue.lock);
+
+                if (shouldExit.get() != 0)
+                    return;
+
+                queue.tasks.push_back(task);
+            }
+
+            wakeUp(index);
+        }
+
+        void submitAfter(const juce::RelativeTime& delay, const Task& task)
+        {
+            {
+                const juce::ScopedLock lock(timedTasksLock);
+
+                if (shouldExit.get() != 0)
+                    return;
+
+                timedTasks.emplace(juce::Time::getMillisecondCounterHiRes() + delay.inSeconds() * 1000.0, task);
+                ++numTimedTasks;
+            }
+
+            // The thread that waits for the next deadline may have to wait for this one instead. If no thread waits, a sleeping thread takes over.
+            const int waiter = timerWaiter.get();
+
+            if (waiter > 0)
+                queues[static_cast<size_t>(waiter - 1)]->wakeUp.signal();
+            else
+                wakeUp(0);
+        }
+
+        // Wakes up the thread with the given index if it's sleeping, or another sleeping thread that can steal the task
+        void wakeUp(size_t index)
+        {
+            for (size_t i = 0; i < queues.size(); i++) {
+                Queue& queue = *queues[(index + i) % queues.size()];
+
+                if (queue.isSleeping.get() != 0) {
+                    queue.wakeUp.signal();
+                    return;
+                }
+            }
+        }
+
+        void shutDown()
+        {
+            shouldExit = 1;
+
+            for (auto& queue : queues)
+                queue->wakeUp.signal();
+        }
+
+        void discardTasks()
+        {
+            // Destroyed outside of the locks, because destroying a task may release a worker, which may submit a task
+            std::vector<Task> discarded;
+            std::multimap<double, Task> discardedTimedTasks;
+
+            for (auto& queue : queues) {
+                const juce::SpinLock::ScopedLockType lock(queue->lock);
+                std::move(queue->tasks.begin(), queue->tasks.end(), std::back_inserter(discarded));
+                queue->tasks.clear();
+            }
+
+            {
+                const juce::ScopedLock lock(timedTasksLock);
+                discardedTimedTasks.swap(timedTasks);
+                numTimedTasks = 0;
+            }
+        }
+
+        int getCurrentThreadIndex() const
+        {
+            // The thread IDs are complete once the constructor has returned
+            if (hasStarted.get() == 0)
+                return -1;
+
+            const auto currentId = std::this_thread::get_id();
+
+            for (size_t i = 0; i < threadIds.size(); i++) {
+                if (threadIds[i] == currentId)
+                    return static_cast<int>(i);
+            }
+
+            return -1;
+        }
+
+        void run(size_t index)
+        {
+            Queue& queue = *queues[index];
+            Task task;
+            int appliedOptionsVersion = -1;
+            ThreadOptions appliedOptions;
+
+            while (shouldExit.get() == 0) {
+                if (optionsVersion.get() != appliedOptionsVersion) {
+                    appliedOptionsVersion = optionsVersion.get();
+                    applyOptions(index, appliedOptions);
+                }
+
+                if (takeTask(index, task)) {
+                    handOverTimer(index);
+                    task();
+                    task = nullptr;
+                    continue;
+                }
+
+                // Announce that this thread is going to sleep, and check again. So a task that is submitted in between is not missed.
+                queue.isSleeping = 1;
+                const bool isTimerWaiter = (numTimedTasks.get() > 0 && timerWaiter.compareAndSetBool(static_cast<int>(index) + 1, 0));
+
+                if (takeTask(index, task)) {
+                    queue.isSleeping = 0;
+
+                    if (isTimerWaiter)
+                        timerWaiter = 0;
+
+                    handOverTimer(index);
+                    task();
+                    task = nullptr;
+                    continue;
+                }
+
+                queue.wakeUp.wait(isTimerWaiter ? getMillisecondsUntilNextDeadline() : -1);
+                queue.isSleeping = 0;
+
+                if (isTimerWaiter)
+                    timerWaiter = 0;
+            }
+        }
+
+        // Called before running a task. If there are timed tasks, but no thread waits for them (e.g. because the waiting thread has just got a task), a sleeping thread takes over.
+        void handOverTimer(size_t index)
+        {
+            if (numTimedTasks.get() > 0 && timerWaiter.get() == 0)
+                wakeUp(index + 1);
+        }
+
+        bool takeTask(size_t index, Task& task)
+        {
+            moveDueTimedTasks(index);
+
+            // Own queue first, then steal from the others
+            for (size_t i = 0; i < queues.size(); i++) {
+                Queue& queue = *queues[(index + i) % queues.size()];
+                const juce::SpinLock::ScopedLockType lock(queue.lock);
+
+                if (!queue.tasks.empty()) {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void moveDueTimedTasks(size_t index)
+        {
+            // Most of the time there are none, so this avoids the lock
+            if (numTimedTasks.get() == 0)
+                return;
+
+            const juce::ScopedLock lock(timedTasksLock);
+
+            if (timedTasks.empty())
+                return;
+
+            const auto due = timedTasks.upper_bound(juce::Time::getMillisecondCounterHiRes());
+
+            if (due == timedTasks.begin())
+                return;
+
+            {
+                Queue& queue = *queues[index];
+                const juce::SpinLock::ScopedLockType queueLock(queue.lock);
+
+                for (auto it = timedTasks.begin(); it != due; ++it) {
+                    queue.tasks.push_back(std::move(it->second));
+                    --numTimedTasks;
+                }
+            }
+
+            timedTasks.erase(timedTasks.begin(), due);
+        }
+
+        int getMillisecondsUntilNextDeadline()
+        {
+            const juce::ScopedLock lock(timedTasksLock);
+
+            if (timedTasks.empty())
+                return -1;
+
+            const double milliseconds = timedTasks.begin()->first - juce::Time::getMillisecondCounterHiRes();
+            return juce::jmax(1, static_cast<int>(std::ceil(milliseconds)));
+        }
+    };
+
+    const State::Ptr state;
+    std::vector<std::thread> threads;
+
+    JUCE_DECLARE_NON_COPYABLE(ThreadPool)
+};
+
+/**
+ Runs the actions of one subscription on a ThreadPool.
+
+ If it's serialized, the actions run one after the other, in the order in which they were scheduled (but not necessarily on the same thread). A serialized worker only occupies a pool thread while it has actions, and yields the thread after a few actions, so other workers get their turn.
+ */
+class ThreadPoolWorker : public PushWorker
+{
+public:
+    ThreadPoolWorker(const ThreadPool::Ptr& pool, bool isSerialized)
+    : pool(pool),
+      isSerialized(isSerialized)
+    {}
+
+    void schedule(const std::function<void()>& action) override
+    {
+        if (!isSerialized) {
+            pool->submit(makeTask(action));
+            return;
+        }
+
+        {
+            const juce::SpinLock::ScopedLockType scopedLock(lock);
+            actions.push_back(action);
+
+            if (isRunning)
+                return;
+
+            isRunning = true;
+        }
+
+        submitRun();
+    }
+
+    void scheduleAfter(const juce::RelativeTime& delay, const std::function<void()>& action) override
+    {
+        // When the delay has passed, the action is scheduled like any other action, so it's serialized with them
+        const Ptr self(this);
+        pool->submitAfter(delay, [self, action]() { self->schedule(action); });
+    }
+
+    // Whether the calling thread runs this worker's actions: While one of them is running, or always on the thread of a single-thread pool (which may run other workers' actions in between). Other threads of a larger pool may wait for this worker.
+    bool isCurrentThread() const override
+    {
+        return (getRunningWorker() == this || (pool->getNumThreads() == 1 && pool->isPoolThread()));
+    }
+
+    void dispose() override
+    {
+        isDisposed = 1;
+
+        // The queued actions won't run anymore. Release them now, because they may reference this worker.
+        std::deque<std::function<void()>> discarded;
+        const juce::SpinLock::ScopedLockType scopedLock(lock);
+        discarded.swap(actions);
+    }
+
+private:
+    const ThreadPool::Ptr pool;
+    const bool isSerialized;
+    juce::SpinLock lock;
+    std::deque<std::function<void()>> actions;
+    bool isRunning = false;
+    juce::Atomic<int> isDisposed;
+
+    // The number of actions a serialized worker runs before it yields its thread
+    static const int MaxActionsPerRun = 32;
+
+    // The worker whose action is running on the calling thread, or nullptr
+    static ThreadPoolWorker*& getRunningWorker()
+    {
+        thread_local ThreadPoolWorker* runningWorker = nullptr;
+        return runningWorker;
+    }
+
+    void runAction(const std::function<void()>& action)
+    {
+        if (isDisposed.get() != 0)
+            return;
+
+        ThreadPoolWorker* const previousWorker = getRunningWorker();
+        getRunningWorker() = this;
+        action();
+        getRunningWorker() = previousWorker;
+    }
+
+    ThreadPool::Task makeTask(const std::function<void()>& action)
+    {
+        // Keep this worker alive until the action has run
+        const Ptr self(this);
+        return [this, self, action]() { runAction(action); };
+    }
+
+    void submitRun()
+    {
+        const Ptr self(this);
+        pool->submit([this, self]() { runActions(); });
+    }
+
+    void runActions()
+    {
+        for (int i = 0; i < MaxActionsPerRun; i++) {
+            std::function<void()> action;
+
+            {
+                const juce::SpinLock::ScopedLockType scopedLock(lock);
+
+                if (actions.empty()) {
+                    isRunning = false;
+                    return;
+                }
+
+                action = std::move(actions.front());
+                actions.pop_front();
+            }
+
+            runAction(action);
+        }
+
+        // Continue later, after the other tasks in the pool
+        submitRun();
+    }
+};
+
+/**
+ A bounded set of single-thread pools, which back Scheduler::newThread. Each worker is bound to one thread for its lifetime, so its actions run in order, on the same thread.
+
+ A new worker gets an idle thread (one without workers) if there is one, or a new thread while there are fewer than maxThreads. Otherwise, it shares the thread with the fewest workers. When all workers of a thread are gone, the thread is kept for the next worker.
+ */
+class ThreadCache : public juce::ReferenceCountedObject
+{
+public:
+    typedef juce::ReferenceCountedObjectPtr<ThreadCache> Ptr;
+
+    ThreadCache(int maxThreads, const ThreadOptions& options)
+    : maxThreads(static_cast<size_t>(juce::jmax(1, maxThreads))),
+      options(options)
+    {}
+
+    PushWorker::Ptr createWorker()
+    {
+        const juce::ScopedLock lock(criticalSection);
+        const size_t index = findThread();
+        entries[index].numWorkers++;
+
+        return new Worker(this, index, entries[index].thread);
+    }
+
+    int getNumThreads() const
+    {
+        const juce::ScopedLock lock(criticalSection);
+        return static_cast<int>(entries.size());
+    }
+
+    // Applies to the running threads, and to the ones that are created later
+    void setOptions(const ThreadOptions& newOptions)
+    {
+        const juce::ScopedLock lock(criticalSection);
+        options = newOptions;
+
+        for (auto& entry : entries)
+            entry.thread->setOptions(options);
+    }
+
+    // Shuts down all threads. See ThreadPool::shutDown.
+    void shutDown()
+    {
+        std::vector<ThreadPool::Ptr> threads;
+
+        {
+            const juce::ScopedLock lock(criticalSection);
+
+            for (auto& entry : entries)
+                threads.push_back(entry.thread);
+        }
+
+        // Without the lock, because discarded tasks may release their workers
+        for (auto& thread : threads)
+            thread->shutDown();
+    }
+
+private:
+    struct Entry
+    {
+        ThreadPool::Ptr thread;
+        int numWorkers;
+    };
+
+    // Tasks run in order on a single thread, so the worker doesn't need to serialize them
+    class Worker : public ThreadPoolWorker
+    {
+    public:
+        Worker(const ThreadCache::Ptr& cache, size_t index, const ThreadPool::Ptr& thread)
+        : ThreadPoolWorker(thread, false),
+          cache(cache),
+          index(index)
+        {}
+
+        ~Worker()
+        {
+            release();
+        }
+
+        void dispose() override
+        {
+            ThreadPoolWorker::dispose();
+            release();
+        }
+
+    private:
+        const ThreadCache::Ptr cache;
+        const size_t index;
+        juce::Atomic<int> isReleased;
+
+        void release()
+        {
+            if (isReleased.exchange(1) == 0)
+                cache->release(index);
+        }
+    };
+
+    const size_t maxThreads;
+    juce::CriticalSection criticalSection;
+    ThreadOptions options;
+    std::vector<Entry> entries;
+
+    size_t findThread()
+    {
+        size_t leastBusy = 0;
+
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].numWorkers == 0)
+                return i;
+
+            if (entries[i].numWorkers < entries[leastBusy].numWorkers)
+                leastBusy = i;
+        }
+
+        if (entries.size() < maxThreads) {
+            entries.push_back(Entry{ new ThreadPool(1, options), 0 });
+            return entries.size() - 1;
+        }
+
+        return leastBusy;
+    }
+
+    void release(size_t index)
+    {
+        const juce::ScopedLock lock(criticalSection);
+        entries[index].numWorkers--;
+    }
+};
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+/**
+ An Observable that shares a single subscription to its source between all of its subscribers. Subscribers only receive values after connect() has been called.
+
+ Use it to subscribe multiple Observers before the source starts emitting, so they all receive the same values. If you just want to share an Observable, use Observable::share instead.
+
+ @see Observable::publish
+ */
+template<typename T>
+class ConnectableObservable : public Observable<T>
+{
+public:
+    /**
+     Subscribes to the source Observable, so all subscribers start to receive values. Does nothing if it's already connected.
+
+     Returns the connection. Unsubscribing from it disconnects, and calling connect() again subscribes to the source again. If the source completes, it disconnects automatically.
+     */
+    Subscription connect() const
+    {
+        return this->impl.connect();
+    }
+
+    /**
+     Returns an Observable that connects when the first Observer subscribes, and disconnects when the last one unsubscribes. @see Observable::share
+     */
+    Observable<T> refCount() const
+    {
+        return this->impl.refCount();
+    }
+
+private:
+    template<typename U>
+    friend class Observable;
+
+    explicit ConnectableObservable(const detail::ObservableImpl& impl)
+    : Observable<T>(impl)
+    {}
+
+    JUCE_LEAK_DETECTOR(ConnectableObservable)
+};
@@ -1,12 +1,12 @@
 DisposeBag::DisposeBag()
-: wrapped(rxcpp::composite_subscription()) {}
+: wrapped(detail::PushSubscription::Ptr(new detail::PushSubscription())) {}
 
 DisposeBag::~DisposeBag()
 {
-    wrapped.get<rxcpp::composite_subscription>().unsubscribe();
+    wrapped.get<detail::PushSubscription::Ptr>()->unsubscribe();
 }
 
 void DisposeBag::insert(const Subscription& subscription)
 {
-    wrapped.get<rxcpp::composite_subscription>().add(subscription.wrapped.get<rxcpp::subscription>());
+    wrapped.get<detail::PushSubscription::Ptr>()->add([subscription]() { subscription.unsubscribe(); });
 }
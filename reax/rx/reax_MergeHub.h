@@ -0,0 +1,67 @@
+#pragma once
+
+/**
+ Merges a changing set of Observables into one Observable. Use this when the sources come and go at runtime, like one Observable per voice or per track.
+
+ Call add() to subscribe to a source, and remove() with the returned Handle to unsubscribe from it. Both take constant time, and the other sources stay subscribed. A source is removed automatically when it completes. If a source notifies onError, the error is forwarded and the MergeHub stops: It unsubscribes from all sources, and ignores new ones.
+
+ Like a PublishSubject, the Observable is hot: The sources are subscribed to when they are added, and subscribers only get the values that are emitted after they have subscribed. The values are serialized, so the sources may emit on different threads.
+
+     MergeHub<MidiMessage> notes;
+     notes.asObservable().subscribe([&](const MidiMessage& message) { keyboard.update(message); }).disposedBy(disposeBag);
+
+     const auto handle = notes.add(voice.getNotes());
+     // When the voice stops:
+     notes.remove(handle);
+
+ When the MergeHub is destroyed, it unsubscribes from all sources, and its Observable completes.
+ */
+template<typename T>
+class MergeHub
+{
+public:
+    /// Identifies a source that has been added to a MergeHub.
+    typedef detail::MergeHubImpl::Handle Handle;
+
+    /// Creates a new instance without any sources.
+    MergeHub() {}
+
+    /// Unsubscribes from all sources, and completes the Observable.
+    ~MergeHub()
+    {
+        impl.complete();
+    }
+
+    /**
+     Subscribes to the source, and emits its values from the MergeHub's Observable. Returns a Handle, which you can pass to remove() to unsubscribe from the source.
+     */
+    Handle add(const Observable<T>& source)
+    {
+        return impl.add(source.impl);
+    }
+
+    /**
+     Unsubscribes from the source with the given Handle. Does nothing if the source has already been removed (or has completed).
+     */
+    void remove(Handle handle)
+    {
+        impl.remove(handle);
+    }
+
+    /// Returns the number of sources that are currently subscribed to.
+    int getNumSources() const
+    {
+        return static_cast<int>(impl.getNumSources());
+    }
+
+    /// Returns an Observable that emits the values from all sources.
+    Observable<T> asObservable() const
+    {
+        return impl.asObservable();
+    }
+
+private:
+    const detail::MergeHubImpl impl;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MergeHub)
+};
@@ -3,6 +3,12 @@
 template<typename T>
 class Observer;
 
+template<typename T>
+class ConnectableObservable;
+
+template<typename T>
+class MergeHub;
+
 /**
  An Observable emits values over time.
  
@@ -30,6 +36,10 @@ public:
     struct IsObservable<Observable<U>> : std::true_type
     {
     };
+    template<typename U>
+    struct IsObservableArray : std::is_same<U, juce::Array<Observable<T>>>
+    {
+    };
     template<typename Function, typename... Args>
     using CallResult = typename std::result_of<Function(Args...)>::type;
     /// \endcond
@@ -126,6 +136,17 @@ public:
         return Impl::interval(interval);
     }
 
+    /**
+     Like Observable::interval, but emits the values on the given Scheduler, so subscribing doesn't block. The first value is emitted as soon as the scheduler runs it.
+
+     With Scheduler::virtualTime, the values are emitted when the virtual clock is advanced.
+     */
+    template<typename U = T>
+    static Observable<T> interval(const juce::RelativeTime& interval, const Scheduler& scheduler, typename std::enable_if<std::is_same<U, T>::value && std::is_same<int, T>::value>::type* = 0)
+    {
+        return Impl::interval(interval, *scheduler.impl);
+    }
+
     /**
      Creates an Observable which emits a single value.
      
@@ -234,10 +255,106 @@ public:
 
         return impl.map(convert).subscribe(observer.impl);
     }
+
+    /// Subscribes an Observer of the same type. The values are passed on without converting (or copying) them, so this also works for move-only types.
+    Subscription subscribe(const Observer<T>& observer) const
+    {
+        return impl.subscribe(observer.impl);
+    }
+
+    /**
+     Subscribes with flow control: The Observable may only emit `initialRequest` values, until you request more with Subscription::request. Use this when a fast producer would otherwise flood a slow consumer.
+
+     The demand is passed on through operators like `map` and `filter`, up to the Observable::create producer. A producer that supports flow control checks Observer::hasDemand before emitting, and continues when its Observer::setOnRequest function is called. Other producers (and operators that combine several Observables) ignore the demand, and emit all of their values.
+
+         const auto subscription = Observable<int>::create([](const Observer<int>& observer) {
+             ...
+         }).subscribeWithDemand(16, [&](int i) {
+             queue.push(i);
+         });
+
+         // Later, when the values have been processed:
+         subscription.request(16);
+     */
+    Subscription subscribeWithDemand(unsigned int initialRequest,
+                                     const std::function<void(const T&)>& onNext,
+                                     const std::function<void(std::exception_ptr)>& onError = Impl::TerminateOnError,
+                                     const std::function<void()>& onCompleted = Impl::EmptyOnCompleted) const
+    {
+        return impl.subscribeWithDemand(initialRequest, [onNext](const any& next) {
+            onNext(next.get<T>());
+        },
+                                        onError,
+                                        onCompleted);
+    }
         ///@}
 
 
 #pragma mark - Operators
+    /**
+     Collects the values from this Observable into batches of `count` values, and emits each batch as an Array. When this Observable completes, the remaining values are emitted as a smaller batch.
+     
+     Use this to process values in blocks, for example one batch per audio block from a LockFreeSource. The Array's storage is reused for each batch, so if you need to keep a batch, copy it.
+     */
+    Observable<juce::Array<T>> bufferWithCount(unsigned int count) const
+    {
+        // The count must be > 0.
+        jassert(count > 0);
+
+        return batch(count, count, juce::RelativeTime());
+    }
+
+    /**
+     Collects the values from this Observable, and emits them as an Array every `interval`. Empty batches are not emitted. When this Observable completes, the remaining values are emitted.
+     
+     The batches are emitted on the message thread, except for the last one, which is emitted when this Observable completes (on the thread that completes it). Use this to update the GUI once per frame, instead of once per value:
+     
+         LockFreeSource<float> samples(1024);
+         samples.bufferWithTime(RelativeTime::milliseconds(16)).subscribe([&](const Array<float>& batch) {
+             scope.addSamples(batch);
+         }).disposedBy(disposeBag);
+     
+     The Array's storage is reused for each batch, so if you need to keep a batch, copy it.
+     */
+    Observable<juce::Array<T>> bufferWithTime(const juce::RelativeTime& interval) const
+    {
+        return batch(0, 0, interval);
+    }
+
+    /**
+     Like Observable::bufferWithTime, but measures the time and emits the batches on the given Scheduler. The first batch is emitted one `interval` after subscribing.
+
+     Use Scheduler::virtualTime to test or benchmark it without waiting.
+     */
+    Observable<juce::Array<T>> bufferWithTime(const juce::RelativeTime& interval, const Scheduler& scheduler) const
+    {
+        return batch(0, 0, interval, scheduler.impl);
+    }
+
+    /**
+     Like Observable::bufferWithTime, but also emits a batch as soon as it has `count` values.
+
+     A batch that is full is emitted right away, on the thread that has emitted its last value. The other batches are emitted on the message thread. So if this Observable emits on another thread, the observer is called on both threads (one call at a time, never at the same time). Add `observeOn(Scheduler::messageThread())` if the observer must run on the message thread.
+     */
+    Observable<juce::Array<T>> bufferWithTimeOrCount(const juce::RelativeTime& interval, unsigned int count) const
+    {
+        // The count must be > 0.
+        jassert(count > 0);
+
+        return batch(count, count, interval);
+    }
+
+    /**
+     Like Observable::bufferWithTimeOrCount, but measures the time and emits the batches that aren't full on the given Scheduler.
+     */
+    Observable<juce::Array<T>> bufferWithTimeOrCount(const juce::RelativeTime& interval, unsigned int count, const Scheduler& scheduler) const
+    {
+        // The count must be > 0.
+        jassert(count > 0);
+
+        return batch(count, count, interval, scheduler.impl);
+    }
+
     ///@{
     /**
      Returns an Observable that emits **whenever** a value is emitted by either this Observable **or** one of the `others`. It combines the **latest** value from each Observable via the given function and emits what was returned by the function.
@@ -252,11 +369,11 @@ public:
         return combineLatest(std::make_tuple<const T&, const Ts&...>, others...);
     }
     /// \overload
-    template<typename... Ts, typename Function>
+    template<typename... Ts, typename Function, typename = typename std::enable_if<!IsObservableArray<typename std::decay<Function>::type>::value>::type>
     Observable<CallResult<Function, T, Ts...>> combineLatest(Function&& function, const Observable<Ts>&... others) const
     {
         static_assert(sizeof...(Ts) > 0, "Must pass at least one other Observable to combineLatest.");
-        static_assert(sizeof...(Ts) <= Impl::MaximumArity, "Too many Observables passed to combineLatest.");
+        static_assert(sizeof...(Ts) <= Impl::MaximumArity, "Too many Observables passed to combineLatest. Use the overload that takes an Array of Observables.");
 
         const std::function<any(const any&, const typename any_args<Ts>::type&...)> untypedFunction = [function](const any& v, const typename any_args<Ts>::type&... vs) {
             return toAny(function(v.get<T>(), vs.template get<Ts>()...));
@@ -266,6 +383,26 @@ public:
     }
     ///@}
 
+    /**
+     Like Observable::combineLatest, but for any number of Observables of the same type. Emits an Array with the latest value from each Observable (in the same order as `observables`).
+     
+     It starts emitting when each Observable has emitted a value. After that, a new value only replaces its slot in the Array, so each change takes constant time, no matter how many Observables there are. For example, to combine all parameters of a plugin into one stream:
+     
+         Array<Observable<float>> parameters;
+         for (auto parameter : processor.getParameters())
+             parameters.add(parameterObservable(parameter));
+         
+         Observable<float>::combineLatest(parameters).subscribe([](const Array<float>& values) {
+             // ...
+         });
+     
+     The Array's storage is reused for each emission, so if you need to keep it, copy it. If `observables` is empty, the returned Observable completes immediately.
+     */
+    static Observable<juce::Array<T>> combineLatest(const juce::Array<Observable<T>>& observables)
+    {
+        return combine(observables, detail::Combiner<T>::Kind::CombineLatest);
+    }
+
     /**
      Returns an Observable that first emits the values from this Observable, then from the first in the `others` list, then from the second, and so on.
      
@@ -276,9 +413,6 @@ public:
         // Must pass at least one other Observable:
         jassert(others.size() > 0);
 
-        // Too many Observables passed to concat:
-        jassert(others.size() <= Impl::MaximumArity);
-
         juce::Array<Impl> otherImpls;
         for (auto& other : others)
             otherImpls.add(other.impl);
@@ -286,6 +420,30 @@ public:
         return impl.concat(otherImpls);
     }
 
+    /**
+     Like Observable::concat, but for any number of Observables. Emits the values from the first Observable in `observables`, then from the second, and so on. If `observables` is empty, the returned Observable completes immediately.
+     */
+    static Observable<T> concat(const juce::Array<Observable<T>>& observables)
+    {
+        if (observables.isEmpty())
+            return empty();
+
+        return observables.getFirst().impl.concat(implsOf(observables, 1));
+    }
+
+    /**
+     For each emitted value, calls `f` and subscribes to the Observable returned from `f`, **one after the other**. It only calls `f` for the next value when the previous returned Observable has completed, so the emitted values don't interleave.
+     
+     This is the same as `flatMap(f, 1, prefetch)`. Use it to process requests in order, like loading one file at a time. If this Observable supports flow control, it may only emit `prefetch` values ahead of the returned Observable that is currently subscribed.
+     
+     @see Observable::flatMap, Observable::concat.
+     */
+    template<typename Function, typename = typename std::enable_if<IsObservable<CallResult<Function, T>>::value>::type>
+    Observable<typename CallResult<Function, T>::ValueType> concatMap(Function&& function, unsigned int prefetch = 0) const
+    {
+        return flatMap(std::forward<Function>(function), 1, prefetch);
+    }
+
     /**
      Returns an Observable which emits if `interval` has passed without this Observable emitting a value. The returned Observable emits the latest value from this Observable.
      
@@ -298,6 +456,16 @@ public:
         return impl.debounce(interval);
     }
 
+    /**
+     Like Observable::debounce, but measures the time and emits the values on the given Scheduler. When this Observable completes, a value that is still pending is emitted before onCompleted.
+
+     Use Scheduler::virtualTime to test or benchmark it without waiting.
+     */
+    Observable<T> debounce(const juce::RelativeTime& interval, const Scheduler& scheduler) const
+    {
+        return impl.debounce(interval, *scheduler.impl);
+    }
+
     /**
      Returns an Observable which emits the same values as this Observable, but suppresses consecutive duplicate values.
      
@@ -345,20 +513,30 @@ public:
      
      Will emit the values: `"hello"`, `"HELLO!"`, `"world"` and `"WORLD!"`.
      
-     @see Observable::merge, Observable::switchOnNext.
+     If `maxConcurrent` is > 0, at most that many returned Observables are subscribed to at the same time. The other values are queued, and `f` is called for them when one of the returned Observables has completed. This keeps the amount of concurrent work bounded, for example when loading hundreds of files at once (where `loadFile` returns an Observable that loads the file on a background thread):
+     
+         fileRequests.flatMap([](const File& file) { return loadFile(file); }, 4);
+     
+     The queue is bounded by flow control: This Observable may only emit `maxConcurrent + prefetch` values at first, and one more each time a returned Observable completes. So if it supports flow control (see Observable::subscribeWithDemand), at most `prefetch` values are queued. Values from an Observable without flow control (like a Subject) are queued nonetheless.
+     
+     The returned Observable completes when this Observable and all returned Observables have completed.
+     
+     @see Observable::merge, Observable::concatMap, Observable::switchMap.
      */
-    template<typename Function>
-    Observable<typename CallResult<Function, T>::ValueType> flatMap(Function&& function, typename std::enable_if<IsObservable<CallResult<Function, T>>::value>::type* = 0) const
+    template<typename Function, typename = typename std::enable_if<IsObservable<CallResult<Function, T>>::value>::type>
+    Observable<typename CallResult<Function, T>::ValueType> flatMap(Function&& function, unsigned int maxConcurrent = 0, unsigned int prefetch = 0) const
     {
         return impl.flatMap([function](const any& value) {
             return function(value.get<T>()).impl;
-        });
+        }, maxConcurrent, prefetch);
     }
 
     /**
      For each value emitted by this Observable, call the function with that value and emit the result.
      
      If `f` returns an Observable, you can use Observable::switchOnNext afterwards.
+     
+     The result is moved into the emitted value, so `f` may return a move-only type (like `std::unique_ptr<AudioBuffer<float>>`).
      */
     template<typename Function>
     Observable<CallResult<Function, T>> map(Function&& function) const
@@ -378,9 +556,6 @@ public:
         // Must pass at least one other Observable:
         jassert(others.size() > 0);
 
-        // Too many Observables:
-        jassert(others.size() <= Impl::MaximumArity);
-
         juce::Array<Impl> otherImpls;
         for (auto& other : others)
             otherImpls.add(other.impl);
@@ -388,6 +563,17 @@ public:
         return impl.merge(otherImpls);
     }
 
+    /**
+     Like Observable::merge, but for any number of Observables. The returned Observable completes when all of them have completed. If `observables` is empty, it completes immediately.
+     */
+    static Observable<T> merge(const juce::Array<Observable<T>>& observables)
+    {
+        if (observables.isEmpty())
+            return empty();
+
+        return observables.getFirst().impl.merge(implsOf(observables, 1));
+    }
+
     /**
      Begins with a `startValue`, and then applies `f` to all values emitted by this Observable, and returns the aggregate result as a single-element Observable sequence.
      */
@@ -410,6 +596,16 @@ public:
         return impl.sample(interval);
     }
 
+    /**
+     Like Observable::sample, but measures the time and emits the values on the given Scheduler. The first sample is taken one `interval` after subscribing.
+
+     Use Scheduler::virtualTime to test or benchmark it without waiting.
+     */
+    Observable<T> sample(const juce::RelativeTime& interval, const Scheduler& scheduler) const
+    {
+        return impl.sample(interval, *scheduler.impl);
+    }
+
     /**
      Calls a function `f` with the given `startValue` and the first value emitted by this Observable. The value returned from `f` is remembered. When the second value is emitted, `f` is called with the remembered value (called the *accumulator*) and the second emitted value. The returned value is remembered, until the third value is emitted, and so on.
      
@@ -468,6 +664,21 @@ public:
         return impl.switchOnNext();
     }
 
+    /**
+     For each emitted value, calls `f` and subscribes to the Observable returned from `f`, after **unsubscribing** from the previously returned Observable. So it only emits the values from the latest returned Observable.
+     
+     Use this if only the result for the latest value is needed, like when loading a preview for the selected file: Selecting another file cancels the previous load.
+     
+     This is the same as `map(f).switchOnNext()`.
+     */
+    template<typename Function, typename = typename std::enable_if<IsObservable<CallResult<Function, T>>::value>::type>
+    Observable<typename CallResult<Function, T>::ValueType> switchMap(Function&& function) const
+    {
+        return impl.switchMap([function](const any& value) {
+            return function(value.get<T>()).impl;
+        });
+    }
+
     /**
      Returns an Observable that emits only the first `numValues` values from this Observable.
      */
@@ -505,6 +716,21 @@ public:
         });
     }
 
+    /**
+     Emits a sliding window over the values from this Observable: The most recent `count` values, as an Array, each time this Observable has emitted `skip` new values. Only full windows are emitted.
+     
+     If `skip` < `count`, the windows overlap. For example, `window(4, 2)` emits [1, 2, 3, 4], [3, 4, 5, 6], etc. If `skip` > `count`, values are dropped between the windows. Unlike ReactiveX's window operator, this emits Arrays, not Observables.
+     
+     The Array's storage is reused for each window, so if you need to keep a window, copy it.
+     */
+    Observable<juce::Array<T>> window(unsigned int count, unsigned int skip = 1) const
+    {
+        // The count and skip must be > 0.
+        jassert(count > 0 && skip > 0);
+
+        return batch(count, skip, juce::RelativeTime());
+    }
+
     ///@{
     /**
      Returns an Observable that emits whenever a value is emitted by **this Observable**. It combines the latest value from each Observable via the given function and emits the result of this function.
@@ -545,11 +771,11 @@ public:
         return zip(std::make_tuple<const T&, const Ts&...>, others...);
     }
     /// \overload
-    template<typename... Ts, typename Function>
+    template<typename... Ts, typename Function, typename = typename std::enable_if<!IsObservableArray<typename std::decay<Function>::type>::value>::type>
     Observable<CallResult<Function, T, Ts...>> zip(Function&& function, const Observable<Ts>&... others) const
     {
         static_assert(sizeof...(Ts) > 0, "Must pass at least one other Observable to zip.");
-        static_assert(sizeof...(Ts) <= Impl::MaximumArity, "Too many Observables passed to zip.");
+        static_assert(sizeof...(Ts) <= Impl::MaximumArity, "Too many Observables passed to zip. Use the overload that takes an Array of Observables.");
 
         const std::function<any(const any&, const typename any_args<Ts>::type&...)> untypedFunction = [function](const any& v, const typename any_args<Ts>::type&... vs) {
             return toAny(function(v.get<T>(), vs.template get<Ts>()...));
@@ -557,7 +783,17 @@ public:
 
         return impl.zip({ others.impl... }, toAny(untypedFunction));
     }
-        ///@}
+    ///@}
+
+    /**
+     Like Observable::zip, but for any number of Observables of the same type. Emits an Array with the next value from each Observable (in the same order as `observables`), whenever each of them has emitted a new value.
+     
+     The Array's storage is reused for each emission, so if you need to keep it, copy it. If `observables` is empty, the returned Observable completes immediately.
+     */
+    static Observable<juce::Array<T>> zip(const juce::Array<Observable<T>>& observables)
+    {
+        return combine(observables, detail::Combiner<T>::Kind::Zip);
+    }
 
 
 #pragma mark - Scheduling
@@ -581,8 +817,89 @@ public:
         return impl.observeOn(*scheduler.impl);
     }
 
+    /**
+     Like observeOn, but the values are passed to the scheduler through a queue that holds at most `capacity` values. Use this if the Observable may emit faster than the scheduler can process the values, e.g. when observing values from the audio thread on the message thread.
+
+     The queue requests `capacity` values from this Observable, and requests another one for each value it emits. So a producer that supports flow control (see Observable::subscribeWithDemand) never overflows the queue. For other producers, the OverflowStrategy determines what happens when the queue is full.
+
+     The queued values are emitted in batches: A burst of values only schedules one call on the scheduler.
+
+     @see OverflowStrategy
+     */
+    Observable<T> observeOn(const Scheduler& scheduler, unsigned int capacity, OverflowStrategy strategy) const
+    {
+        // OverflowStrategy has the same order as detail::PushOverflow
+        return impl.observeOn(*scheduler.impl, capacity, static_cast<detail::PushOverflow>(strategy));
+    }
+
+    /**
+     Like observeOn, but only emits the latest value: If the Observable emits several values before the scheduler gets to them, only the last one is emitted. At most one call is pending on the scheduler at any time.
+
+     Use this for state where only the most recent value matters, like a slider value or a level meter. Then the message thread processes at most one value per dispatch, however fast the values arrive:
+
+         levels.observeOnLatest(Scheduler::messageThread())
+             .subscribe([&](float level) { meter.setLevel(level); })
+             .disposedBy(disposeBag);
+     */
+    Observable<T> observeOnLatest(const Scheduler& scheduler) const
+    {
+        return impl.observeOnLatest(*scheduler.impl);
+    }
+
+
+#pragma mark - Multicasting
+    /**
+     Returns a ConnectableObservable that shares a single subscription to this Observable between all of its subscribers. It starts emitting when you call ConnectableObservable::connect.
+
+     @see share
+     */
+    ConnectableObservable<T> publish() const
+    {
+        return ConnectableObservable<T>(impl.publish(0));
+    }
+
+    /**
+     Returns an Observable that shares a single subscription to this Observable between all of its subscribers.
+
+     Normally, each subscriber runs the whole chain of operators (and for example each `map` function) separately. With share, the chain up to this point runs only once per value, and the result is emitted to all subscribers:
+
+         auto formatted = slider.rx.value.map(expensiveFormat).share();
+         formatted.subscribe(label1.rx.text);
+         formatted.subscribe(label2.rx.text); // Doesn't call expensiveFormat again
+
+     It subscribes to this Observable when the first subscriber subscribes, and unsubscribes when the last one unsubscribes. If this Observable completes, the next subscriber starts a new subscription.
+
+     This is the same as `publish().refCount()`.
+     */
+    Observable<T> share() const
+    {
+        return impl.publish(0).refCount();
+    }
+
+    /**
+     Like share, but remembers the last `bufferSize` values, and emits them to each new subscriber.
+
+     Use this if subscribers need the current state when they subscribe, for example for a value that is expensive to compute. The values are kept when all subscribers have unsubscribed, until this Observable completes.
+     */
+    Observable<T> shareReplay(unsigned int bufferSize = 1) const
+    {
+        return impl.publish(bufferSize).refCount();
+    }
+
 
 #pragma mark - Misc
+    /**
+     Returns an Observable that emits a `shared_ptr<const T>` for each value emitted by this Observable.
+     
+     Large and move-only values (like FFT frames or `std::unique_ptr`s) are not copied: The returned pointers share ownership of the emitted value with all other subscribers. Use this if you need to keep a value after onNext has returned, for example to pass it to another thread.
+     */
+    Observable<std::shared_ptr<const T>> asSharedPointers() const
+    {
+        return impl.map([](const any& value) {
+            return any(value.getShared<T>());
+        });
+    }
+
     /**
      Blocks until the Observable has completed, then returns an Array of all emitted values.
      
@@ -611,6 +928,12 @@ private:
     friend class Observable;
     template<typename U>
     friend class Subject;
+    template<typename U>
+    friend class TypedObservable;
+    template<typename U>
+    friend class ConnectableObservable;
+    template<typename U>
+    friend class MergeHub;
 
     Impl impl;
 
@@ -618,12 +941,82 @@ private:
     : impl(impl)
     {}
 
+    // Implements bufferWithCount, bufferWithTime, bufferWithTimeOrCount and window. If a scheduler is given, the batches are flushed by an interval on it. Otherwise, by a juce::Timer. @see detail::Batcher
+    Observable<juce::Array<T>> batch(unsigned int count, unsigned int skip, const juce::RelativeTime& interval, const std::shared_ptr<detail::SchedulerImpl>& scheduler = nullptr) const
+    {
+        const Impl source = impl;
+
+        return Impl::create([source, count, skip, interval, scheduler](detail::ObserverImpl&& observer) {
+            const typename detail::Batcher<T>::Ptr batcher(new detail::Batcher<T>(observer, count, skip, (scheduler ? juce::RelativeTime() : interval)));
+            if (scheduler) {
+                // The interval ticks right away, so skip that tick
+                const Subscription ticks = Impl::interval(interval, *scheduler).skip(1).subscribe([batcher](const any&) { batcher->flush(); },
+                                                                                                  [](std::exception_ptr) {},
+                                                                                                  []() {});
+                observer.addTeardown([ticks]() { ticks.unsubscribe(); });
+            }
+
+            const Subscription subscription = source.subscribe([batcher](const any& value) { batcher->onNext(value.get<T>()); },
+                                                               [batcher](std::exception_ptr error) { batcher->onError(error); },
+                                                               [batcher]() { batcher->onCompleted(); });
+
+            observer.addTeardown([batcher, subscription]() {
+                subscription.unsubscribe();
+                batcher->stop();
+            });
+        });
+    }
+
+    // Implements the combineLatest and zip overloads for an Array of Observables. @see detail::Combiner
+    static Observable<juce::Array<T>> combine(const juce::Array<Observable<T>>& observables, typename detail::Combiner<T>::Kind kind)
+    {
+        if (observables.isEmpty())
+            return Observable<juce::Array<T>>::empty();
+
+        const juce::Array<Impl> sources = implsOf(observables, 0);
+
+        return Impl::create([sources, kind](detail::ObserverImpl&& observer) {
+            const typename detail::Combiner<T>::Ptr combiner(new detail::Combiner<T>(observer, kind, sources.size()));
+            std::vector<Subscription> subscriptions;
+            subscriptions.reserve(static_cast<size_t>(sources.size()));
+
+            for (int i = 0; i < sources.size() && !combiner->isTerminated(); i++) {
+                subscriptions.push_back(sources[i].subscribe([combiner, i](const any& value) { combiner->onNext(i, value); },
+                                                             [combiner](std::exception_ptr error) { combiner->onError(error); },
+                                                             [combiner, i]() { combiner->onCompleted(i); }));
+            }
+
+            observer.addTeardown([subscriptions]() {
+                for (auto& subscription : subscriptions)
+                    subscription.unsubscribe();
+            });
+        });
+    }
+
+    // The Impls of the given Observables, beginning at startIndex
+    static juce::Array<Impl> implsOf(const juce::Array<Observable<T>>& observables, int startIndex)
+    {
+        juce::Array<Impl> impls;
+        impls.ensureStorageAllocated(observables.size() - startIndex);
+
+        for (int i = startIndex; i < observables.size(); i++)
+            impls.add(observables.getReference(i).impl);
+
+        return impls;
+    }
+
     // Calls the any() constructor, but for Observable<T> it stores the ObservableImpl
     template<typename U>
     static any toAny(const U& u, typename std::enable_if<!IsObservable<U>::value>::type* = 0)
     {
         return any(u);
     }
+    // Moves temporaries into the any, so move-only values are supported
+    template<typename U>
+    static any toAny(U&& u, typename std::enable_if<!std::is_reference<U>::value && !IsObservable<U>::value>::type* = 0)
+    {
+        return any(std::move(u));
+    }
     template<typename U>
     static any toAny(const U& u, typename std::enable_if<IsObservable<U>::value>::type* = 0)
     {
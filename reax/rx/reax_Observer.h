@@ -12,7 +12,11 @@ class Observer
 {
 public:
     ///@{
-    /// Notifies the Observer with a new value.
+    /**
+     Notifies the Observer with a new value.
+     
+     If you pass an rvalue, it's moved into the Observable. This also works for move-only types (like `std::unique_ptr`). Large and move-only values are not copied afterwards: All subscribers get a `const T&` to the same value.
+     */
     void onNext(const T& value) const
     {
         impl.onNext(convert ? convert(detail::any(value)) : detail::any(value));
@@ -24,6 +28,30 @@ public:
     }
     ///@}
 
+    /**
+     Notifies the Observer with a span of values at once.
+
+     Operators that support batches (like `map`, `filter` and `scan`) process the whole span, and other subscribers receive the values one at a time. Each value is boxed as usual. The values are boxed into a fixed-size buffer on the stack, so a large span is passed on in chunks of up to 64 values.
+     */
+    void onNextBatch(const T* values, size_t numValues) const
+    {
+        static const size_t ChunkSize = 64;
+        typename std::aligned_storage<sizeof(detail::any), alignof(detail::any)>::type storage[ChunkSize];
+        detail::any* const chunk = reinterpret_cast<detail::any*>(storage);
+
+        for (size_t start = 0; start < numValues; start += ChunkSize) {
+            const size_t numInChunk = std::min(ChunkSize, numValues - start);
+
+            for (size_t i = 0; i < numInChunk; i++)
+                new (chunk + i) detail::any(convert ? convert(detail::any(values[start + i])) : detail::any(values[start + i]));
+
+            impl.onNextBatch(chunk, numInChunk);
+
+            for (size_t i = 0; i < numInChunk; i++)
+                chunk[i].~any();
+        }
+    }
+
     /// Notifies the Observer that an error has occurred. 
     void onError(std::exception_ptr error) const
     {
@@ -36,6 +64,24 @@ public:
         impl.onCompleted();
     }
 
+    /**
+     Returns whether the subscriber wants more values. Only Observers passed to Observable::create support flow control. It's always true if the subscriber hasn't limited the demand (see Observable::subscribeWithDemand).
+
+     A producer that supports flow control stops emitting when this is false, and continues when the function passed to setOnRequest is called.
+     */
+    bool hasDemand() const
+    {
+        return impl.hasDemand();
+    }
+
+    /**
+     Sets a function that is called whenever the subscriber requests more values. It may be called on any thread, and also synchronously from onNext.
+     */
+    void setOnRequest(const std::function<void()>& onRequest) const
+    {
+        impl.setOnRequest(onRequest);
+    }
+
     /// Contravariant constructor: If T is convertible to U, an Observer<U> is convertible to an Observer<T>. 
     template<typename U>
     Observer(const Observer<U>& other, typename std::enable_if<std::is_convertible<T, U>::value>::type* = 0)
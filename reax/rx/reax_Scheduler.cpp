@@ -2,53 +2,373 @@ namespace
 {
     using namespace juce;
 
-    // A Rx dispatcher for the JUCE message thread. It processes Observables that are observed on it.
-    class JUCEDispatcher  : private Timer
+    // Runs actions on the JUCE message thread. Enqueuing work posts a single message, which runs everything that has been enqueued until then. Timed actions arm a one-shot Timer for the earliest deadline. So the message thread is only woken up when there's work to do.
+    class JUCEDispatcher  : private AsyncUpdater, private Timer
     {
     public:
-        JUCEDispatcher()
-          : runLoop (createRunLoop())
+        typedef std::function<void()> Action;
+
+        ~JUCEDispatcher()
+        {
+            cancelPendingUpdate();
+        }
+
+        void schedule (const Action& action)
+        {
+            {
+                const ScopedLock lock (criticalSection);
+
+                if (isShutDown)
+                    return;
+
+                pendingActions.push_back (action);
+            }
+
+            triggerAsyncUpdate();
+        }
+
+        void setBudget (const DrainBudget& budget)
+        {
+            meter.setBudget (budget);
+        }
+
+        DrainMetrics getMetrics() const
+        {
+            return meter.getMetrics();
+        }
+
+        void scheduleAfter (const RelativeTime& delay, const Action& action)
+        {
+            {
+                const ScopedLock lock (criticalSection);
+
+                if (isShutDown)
+                    return;
+
+                timedActions.emplace (Time::getMillisecondCounterHiRes() + delay.inMilliseconds(), action);
+            }
+
+            // The Timer is re-armed on the message thread
+            triggerAsyncUpdate();
+        }
+
+        // Discards the actions that haven't run yet. Actions that are scheduled afterwards are ignored.
+        void shutDown()
+        {
+            // Destroyed outside of the lock, because destroying an action may release its worker
+            std::vector<Action> discardedActions;
+            std::multimap<double, Action> discardedTimedActions;
+
+            {
+                const ScopedLock lock (criticalSection);
+                isShutDown = true;
+                discardedActions.swap (pendingActions);
+                discardedTimedActions.swap (timedActions);
+            }
+
+            cancelPendingUpdate();
+            stopTimer();
+        }
+
+    private:
+        CriticalSection criticalSection;
+        bool isShutDown = false;
+        std::vector<Action> pendingActions;
+        detail::DrainMeter meter;
+        std::multimap<double, Action> timedActions;
+
+        void handleAsyncUpdate() override
+        {
+            runActions();
+        }
+
+        void timerCallback() override
+        {
+            runActions();
+        }
+
+        void runActions()
+        {
+            // Not a member, because an action may run a nested message loop, which calls this again
+            std::vector<Action> actionsToRun;
+
+            {
+                const ScopedLock lock (criticalSection);
+                actionsToRun.swap (pendingActions);
+
+                const double now = Time::getMillisecondCounterHiRes();
+                const auto due = timedActions.upper_bound (now);
+
+                for (auto it = timedActions.begin(); it != due; ++it)
+                    actionsToRun.push_back (std::move (it->second));
+
+                timedActions.erase (timedActions.begin(), due);
+            }
+
+            if (! actionsToRun.empty())
+                meter.beginCallback();
+
+            // Actions may schedule new actions. Those run in the next callback.
+            for (size_t i = 0; i < actionsToRun.size(); i++)
+            {
+                actionsToRun[i]();
+                meter.addItems (1);
+
+                if (i + 1 < actionsToRun.size() && meter.isExhausted())
+                {
+                    meter.recordExhausted();
+                    postponeActions (actionsToRun.begin() + static_cast<std::ptrdiff_t> (i + 1), actionsToRun.end());
+                    break;
+                }
+            }
+
+            armTimerForEarliestDeadline();
+        }
+
+        // Puts the actions back in front of the pending actions, and runs them in the next callback
+        void postponeActions (std::vector<Action>::iterator begin, std::vector<Action>::iterator end)
         {
-            // The run loop didn't get initialized! Please report this as a bug.
-            jassert (runLoop);
+            {
+                const ScopedLock lock (criticalSection);
+
+                if (isShutDown)
+                    return;
 
-            startTimerHz (60);
+                pendingActions.insert (pendingActions.begin(), std::make_move_iterator (begin), std::make_move_iterator (end));
+            }
+
+            triggerAsyncUpdate();
         }
 
-        rxcpp::observe_on_one_worker createWorker() const
+        void armTimerForEarliestDeadline()
         {
-            return rxcpp::observe_on_run_loop (*runLoop);
+            const ScopedLock lock (criticalSection);
+
+            if (timedActions.empty())
+            {
+                stopTimer();
+                return;
+            }
+
+            const double millisecondsUntilDeadline = timedActions.begin()->first - Time::getMillisecondCounterHiRes();
+            startTimer (jmax (1, roundToInt (std::ceil (millisecondsUntilDeadline))));
+        }
+    };
+
+    ThreadOptions withDefaultName (ThreadOptions options, const String& defaultName)
+    {
+        if (options.name.isEmpty())
+            options.name = defaultName;
+
+        return options;
+    }
+
+    // The schedulers that are shared by everything in the process that uses ReaX. Workers keep them alive while they're used, but SchedulerRegistry shuts them down when its last instance is destroyed.
+    class SharedSchedulers  : public ReferenceCountedObject
+    {
+    public:
+        typedef ReferenceCountedObjectPtr<SharedSchedulers> Ptr;
+
+        explicit SharedSchedulers (const ThreadOptions& options)
+          : dispatcher (new JUCEDispatcher()),
+            newThreads (new detail::ThreadCache (jmax (4, 2 * SystemStats::getNumCpus()), withDefaultName (options, "ReaX Thread"))),
+            options (options)
+        {}
+
+        ~SharedSchedulers()
+        {
+            // The last worker may be released on any thread, but the dispatcher is a Timer, so it's destroyed on the message thread
+            MessageManager* const messageManager = MessageManager::getInstanceWithoutCreating();
+
+            if (messageManager == nullptr || messageManager->isThisTheMessageThread())
+                return;
+
+            JUCEDispatcher* const releasedDispatcher = dispatcher.release();
+            MessageManager::callAsync ([releasedDispatcher] { delete releasedDispatcher; });
+        }
+
+        std::unique_ptr<JUCEDispatcher> dispatcher;
+
+        // The threads of Scheduler::newThread. They are created on demand.
+        const detail::ThreadCache::Ptr newThreads;
+
+        // The pool of Scheduler::backgroundThread. It's created when it's first used, so that only using the message thread doesn't start any threads.
+        detail::ThreadPool::Ptr getBackgroundPool()
+        {
+            const ScopedLock lock (criticalSection);
+
+            if (backgroundPool == nullptr)
+                backgroundPool = new detail::ThreadPool (SystemStats::getNumCpus(), withDefaultName (options, "ReaX Background"));
+
+            return backgroundPool;
+        }
+
+        void setOptions (const ThreadOptions& newOptions)
+        {
+            newThreads->setOptions (withDefaultName (newOptions, "ReaX Thread"));
+
+            const ScopedLock lock (criticalSection);
+            options = newOptions;
+
+            if (backgroundPool != nullptr)
+                backgroundPool->setOptions (withDefaultName (options, "ReaX Background"));
+        }
+
+        void shutDown()
+        {
+            dispatcher->shutDown();
+            newThreads->shutDown();
+
+            detail::ThreadPool::Ptr pool;
+
+            {
+                const ScopedLock lock (criticalSection);
+                pool = backgroundPool;
+            }
+
+            if (pool != nullptr)
+                pool->shutDown();
         }
 
     private:
-        typedef std::unique_ptr<rxcpp::schedulers::run_loop> RunLoop_ptr;
-        const RunLoop_ptr runLoop;
+        CriticalSection criticalSection;
+        ThreadOptions options;
+        detail::ThreadPool::Ptr backgroundPool;
+    };
 
-        static RunLoop_ptr createRunLoop()
+    // Runs actions through the JUCEDispatcher. Actions that are still pending when the worker is disposed don't run.
+    class MessageThreadWorker  : public detail::PushWorker
+    {
+    public:
+        explicit MessageThreadWorker (const SharedSchedulers::Ptr& schedulers)
+          : schedulers (schedulers)
+        {}
+
+        void schedule (const std::function<void()>& action) override
         {
-            // Create the run loop on the message thread:
-            RunLoop_ptr rl;
-            static const auto create = [] (void* rl) {
-                // Not called from the JUCE message thread! Please report this as a bug.
-                jassert (MessageManager::getInstance()->isThisTheMessageThread());
+            schedulers->dispatcher->schedule (makeAction (action));
+        }
+
+        void scheduleAfter (const RelativeTime& delay, const std::function<void()>& action) override
+        {
+            schedulers->dispatcher->scheduleAfter (delay, makeAction (action));
+        }
 
-                *static_cast<RunLoop_ptr*> (rl) = std::make_unique<rxcpp::schedulers::run_loop>();
-                return static_cast<void*> (nullptr);
+        bool isCurrentThread() const override
+        {
+            return MessageManager::getInstance()->isThisTheMessageThread();
+        }
+
+        void dispose() override
+        {
+            isDisposed = 1;
+        }
+
+    private:
+        const SharedSchedulers::Ptr schedulers;
+        Atomic<int> isDisposed;
+
+        JUCEDispatcher::Action makeAction (const std::function<void()>& action)
+        {
+            // Keep this worker alive until the action has run
+            const Ptr self (this);
+            return [this, self, action] {
+                if (isDisposed.get() == 0)
+                    action();
             };
+        }
+    };
 
-            // This will block if this thread isn't the message thread:
-            MessageManager::getInstance()->callFunctionOnMessageThread (create, &rl);
+    // Runs actions on a VirtualClock. It only refers to the clock weakly, so pending actions (which keep their worker alive) don't keep the clock alive.
+    class VirtualWorker  : public detail::PushWorker
+    {
+    public:
+        explicit VirtualWorker (const std::weak_ptr<detail::VirtualClock>& clock)
+          : clock (clock)
+        {}
 
-            return rl;
+        void schedule (const std::function<void()>& action) override
+        {
+            if (auto lockedClock = clock.lock())
+                lockedClock->schedule (lockedClock->getNow(), makeAction (action));
         }
 
-        void timerCallback() override
+        void scheduleAfter (const RelativeTime& delay, const std::function<void()>& action) override
+        {
+            if (auto lockedClock = clock.lock())
+                lockedClock->schedule (lockedClock->getNow() + delay.inSeconds() * 1000.0, makeAction (action));
+        }
+
+        // Actions only run in advanceBy, so waiting for them would never end
+        bool isCurrentThread() const override
         {
-            // Run any scheduled actions
-            while (!runLoop->empty() && runLoop->peek().when < runLoop->now())
-                runLoop->dispatch();
+            return true;
         }
+
+        double now() const override
+        {
+            auto lockedClock = clock.lock();
+            return (lockedClock != nullptr ? lockedClock->getNow() : 0.0);
+        }
+
+        void dispose() override
+        {
+            isDisposed = 1;
+        }
+
+    private:
+        const std::weak_ptr<detail::VirtualClock> clock;
+        Atomic<int> isDisposed;
+
+        detail::VirtualClock::Action makeAction (const std::function<void()>& action)
+        {
+            // Keep this worker alive until the action has run
+            const Ptr self (this);
+            return [this, self, action] {
+                if (isDisposed.get() == 0)
+                    action();
+            };
+        }
+    };
+
+    std::shared_ptr<detail::SchedulerImpl> createVirtualScheduler (const std::weak_ptr<detail::VirtualClock>& clock)
+    {
+        return std::make_shared<detail::SchedulerImpl> ([clock] {
+            return detail::PushWorker::Ptr (new VirtualWorker (clock));
+        });
+    }
+
+    // The current SharedSchedulers, and the number of SchedulerRegistry instances
+    struct Registry
+    {
+        CriticalSection criticalSection;
+        SharedSchedulers::Ptr schedulers;
+        DrainBudget messageThreadBudget;
+        ThreadOptions sharedThreadOptions;
+        int numInstances = 0;
     };
+
+    Registry& getRegistry()
+    {
+        // Never destroyed: Destroying it at exit would shut down the shared schedulers during static destruction, and joining threads there can deadlock (e.g. under the Windows loader lock). The threads simply end with the process.
+        static Registry* const registry = new Registry();
+        return *registry;
+    }
+
+    // Returns the current SharedSchedulers, or creates new ones if they have been shut down
+    SharedSchedulers::Ptr getSharedSchedulers()
+    {
+        Registry& registry = getRegistry();
+        const ScopedLock lock (registry.criticalSection);
+
+        if (registry.schedulers == nullptr)
+        {
+            registry.schedulers = new SharedSchedulers (registry.sharedThreadOptions);
+            registry.schedulers->dispatcher->setBudget (registry.messageThreadBudget);
+        }
+
+        return registry.schedulers;
+    }
 } // namespace
 
 Scheduler::Scheduler (const std::shared_ptr<detail::SchedulerImpl>& impl)
@@ -56,23 +376,127 @@ Scheduler::Scheduler (const std::shared_ptr<detail::SchedulerImpl>& impl)
 
 Scheduler Scheduler::messageThread()
 {
-    static const JUCEDispatcher dispatcher;
-    const auto worker = dispatcher.createWorker();
-    return std::make_shared<detail::SchedulerImpl> ([worker] (const rxcpp::observable<detail::any>& observable) {
-        return observable.observe_on (worker);
+    return std::make_shared<detail::SchedulerImpl> ([] {
+        return detail::PushWorker::Ptr (new MessageThreadWorker (getSharedSchedulers()));
     });
 }
 
+void Scheduler::setMessageThreadBudget (const DrainBudget& budget)
+{
+    Registry& registry = getRegistry();
+    const ScopedLock lock (registry.criticalSection);
+    registry.messageThreadBudget = budget;
+
+    // Schedulers that are created later get the budget in getSharedSchedulers
+    if (registry.schedulers != nullptr)
+        registry.schedulers->dispatcher->setBudget (budget);
+}
+
+DrainMetrics Scheduler::getMessageThreadMetrics()
+{
+    Registry& registry = getRegistry();
+    const ScopedLock lock (registry.criticalSection);
+
+    if (registry.schedulers == nullptr)
+        return DrainMetrics();
+
+    return registry.schedulers->dispatcher->getMetrics();
+}
+
 Scheduler Scheduler::backgroundThread()
 {
-    return std::make_shared<detail::SchedulerImpl> ([] (const rxcpp::observable<detail::any>& observable) {
-        return observable.observe_on (rxcpp::serialize_event_loop());
+    return std::make_shared<detail::SchedulerImpl> ([] {
+        return detail::PushWorker::Ptr (new detail::ThreadPoolWorker (getSharedSchedulers()->getBackgroundPool(), true));
     });
 }
 
 Scheduler Scheduler::newThread()
 {
-    return std::make_shared<detail::SchedulerImpl> ([] (const rxcpp::observable<detail::any>& observable) {
-        return observable.observe_on (rxcpp::serialize_new_thread());
+    return std::make_shared<detail::SchedulerImpl> ([] {
+        return getSharedSchedulers()->newThreads->createWorker();
+    });
+}
+
+Scheduler Scheduler::threadPool (int numThreads, const ThreadOptions& options)
+{
+    const detail::ThreadPool::Ptr pool (new detail::ThreadPool (numThreads > 0 ? numThreads : SystemStats::getNumCpus(), withDefaultName (options, "ReaX Pool")));
+
+    // Operators like debounce and observeOn rely on the actions of a subscription not running in parallel
+    return std::make_shared<detail::SchedulerImpl> ([pool] {
+        return detail::PushWorker::Ptr (new detail::ThreadPoolWorker (pool, true));
     });
 }
+
+void Scheduler::setSharedThreadOptions (const ThreadOptions& options)
+{
+    Registry& registry = getRegistry();
+    const ScopedLock lock (registry.criticalSection);
+    registry.sharedThreadOptions = options;
+
+    if (registry.schedulers != nullptr)
+        registry.schedulers->setOptions (options);
+}
+
+VirtualTimeScheduler Scheduler::virtualTime()
+{
+    return VirtualTimeScheduler();
+}
+
+int Scheduler::getNumThreadsCreated()
+{
+    return detail::ThreadPool::getNumThreadsCreated().get();
+}
+
+VirtualTimeScheduler::VirtualTimeScheduler()
+  : VirtualTimeScheduler (std::make_shared<detail::VirtualClock>())
+{}
+
+VirtualTimeScheduler::VirtualTimeScheduler (const std::shared_ptr<detail::VirtualClock>& clock)
+  : Scheduler (createVirtualScheduler (clock)),
+    clock (clock)
+{}
+
+void VirtualTimeScheduler::advanceBy (const RelativeTime& duration) const
+{
+    clock->advanceBy (duration.inSeconds() * 1000.0);
+}
+
+RelativeTime VirtualTimeScheduler::getNow() const
+{
+    return RelativeTime (clock->getNow() / 1000.0);
+}
+
+SchedulerRegistry::SchedulerRegistry()
+{
+    Registry& registry = getRegistry();
+    const ScopedLock lock (registry.criticalSection);
+    registry.numInstances++;
+}
+
+SchedulerRegistry::~SchedulerRegistry()
+{
+    SharedSchedulers::Ptr schedulers;
+
+    {
+        Registry& registry = getRegistry();
+        const ScopedLock lock (registry.criticalSection);
+
+        if (--registry.numInstances > 0)
+            return;
+
+        // The next user gets new schedulers
+        schedulers = registry.schedulers;
+        registry.schedulers = nullptr;
+    }
+
+    // Without the lock, because discarded actions may release their workers
+    if (schedulers != nullptr)
+        schedulers->shutDown();
+}
+
+int SchedulerRegistry::getNumInstances()
+{
+    Registry& registry = getRegistry();
+    const ScopedLock lock (registry.criticalSection);
+    return registry.numInstances;
+}
@@ -2,8 +2,74 @@
 
 namespace detail {
     struct SchedulerImpl;
+    class VirtualClock;
 }
 
+class VirtualTimeScheduler;
+
+/**
+    Limits how much work is done on the message thread in one callback, so that a burst of values doesn't block the message thread for too long. The remaining work is done in the next callback.
+
+    @see Scheduler::setMessageThreadBudget, LockFreeSource::setDrainBudget
+ */
+struct DrainBudget
+{
+    /// The maximum number of items per callback, or 0 for no limit.
+    int maxItems = 0;
+
+    /// The maximum time per callback, or 0 for no limit. It's checked between items, so a single slow item can exceed it.
+    juce::RelativeTime maxDuration;
+};
+
+/**
+    Counts the work done by the callbacks of a Scheduler or LockFreeSource. Use this to tune a DrainBudget against your UI frame times.
+ */
+struct DrainMetrics
+{
+    /// The number of callbacks.
+    juce::int64 numCallbacks = 0;
+
+    /// The total number of items that have been processed.
+    juce::int64 numItems = 0;
+
+    /// The number of callbacks that have stopped because the DrainBudget was used up.
+    juce::int64 numBudgetExhausted = 0;
+};
+
+/**
+    How the operating system schedules the threads of a Scheduler, relative to other threads.
+
+    @see ThreadOptions
+ */
+enum class ThreadPriority
+{
+    /// Normal priority (SCHED_OTHER with nice level 0 on Linux).
+    Normal,
+
+    /// Below normal, for heavy work that should give way to the audio threads and the UI (nice level 10 on Linux, QOS_CLASS_UTILITY on macOS, THREAD_PRIORITY_BELOW_NORMAL on Windows).
+    Low,
+
+    /// Only runs when a CPU core would be idle otherwise (SCHED_IDLE on Linux, QOS_CLASS_BACKGROUND on macOS, THREAD_PRIORITY_IDLE on Windows).
+    Idle
+};
+
+/**
+    Options for the threads that ReaX creates.
+
+    @see Scheduler::threadPool, Scheduler::setSharedThreadOptions
+ */
+struct ThreadOptions
+{
+    /// The name of the threads, as shown in debuggers and profilers. If it's empty, ReaX chooses a name.
+    juce::String name;
+
+    /// The priority of the threads.
+    ThreadPriority priority = ThreadPriority::Normal;
+
+    /// A bit mask of the CPU cores that the threads may run on (bit 0 is the first core), or 0 for all cores. Use this to keep heavy work away from the cores that run your audio threads. Has no effect on macOS.
+    juce::uint32 affinityMask = 0;
+};
+
 /**
     A Scheduler is used to process parts of an Observable on a specific thread.
  
@@ -17,18 +83,167 @@ public:
     /// The JUCE message thread. 
     static Scheduler messageThread();
 
-    /// A shared background thread. Use this if you don't want to block the message thread, but don't want to spawn a new thread either. The thread is shared between Observables. 
+    /**
+        Shared background threads (one per CPU core). Use this if you don't want to block the message thread, but don't want to spawn a new thread either. The threads are shared between Observables, and the actions of each subscription run one after the other, in order.
+
+        @see SchedulerRegistry
+     */
     static Scheduler backgroundThread();
 
-    /// Makes the Observable spawn a new thread. 
+    /**
+        Runs each subscription on a thread of its own, as long as there are fewer than max(4, 2 * number of CPU cores) subscriptions. Beyond that, subscriptions share threads. The actions of a subscription always run in order, on the same thread.
+
+        Threads are reused: When a subscription ends, its thread is kept for the next one, instead of being destroyed. The threads are shared by everything in the process that uses ReaX.
+
+        @see SchedulerRegistry
+     */
     static Scheduler newThread();
 
+    /**
+        A pool of `numThreads` threads, which share the work: Each thread has its own queue, and an idle thread takes work from the other threads' queues. Use this for independent pipelines that should use all CPU cores, without creating a thread for each of them.
+
+        If numThreads is 0, it creates one thread per CPU core. Each call creates a new pool, so share the returned Scheduler between your Observables. The threads end when the Scheduler and all Observables observed on it have been destroyed.
+
+        The actions of each subscription run one after the other, in order (but not necessarily on the same thread). So each Observable is observed serially, while different Observables run in parallel.
+
+        The options set the name, priority and CPU affinity of the threads.
+     */
+    static Scheduler threadPool(int numThreads = 0, const ThreadOptions& options = ThreadOptions());
+
+    /**
+        Sets the name, priority and CPU affinity of the threads of Scheduler::backgroundThread and Scheduler::newThread. Threads that are already running apply the options when they have finished their current action. Can be called on any thread.
+
+            ThreadOptions options;
+            options.priority = ThreadPriority::Low;
+            options.affinityMask = 0xC; // Only the third and fourth core
+            Scheduler::setSharedThreadOptions(options);
+
+        Lowering the priority always works. But raising it again (e.g. from ThreadPriority::Low back to ThreadPriority::Normal) needs extra privileges on Linux (CAP_SYS_NICE, or a suitable RLIMIT_NICE), because it resets the nice level to 0 and leaves SCHED_IDLE. Without them, the threads silently keep the lower priority. So if you need to switch back, create a separate Scheduler::threadPool with the other priority instead.
+     */
+    static void setSharedThreadOptions(const ThreadOptions& options);
+
+    /// Returns the number of threads that have been created by Scheduler::newThread and Scheduler::threadPool so far. Use this to check that threads are reused.
+    static int getNumThreadsCreated();
+
+    /**
+        Limits how much work Scheduler::messageThread does per message. When the budget is used up, the remaining actions run in the next message, so other messages (like repaints) can be processed in between.
+
+        Each action is one drain of an Observable that is observed on the message thread, which emits the values that were queued when it started, as one batch. Values that arrive while it's emitting are left for another action, so even a producer that is faster than the observer can't hold the message thread. Can be called on any thread. The budget is kept when the shared schedulers are shut down and created again, and calling this doesn't create them.
+     */
+    static void setMessageThreadBudget(const DrainBudget& budget);
+
+    /// Returns how much work Scheduler::messageThread has done since the shared schedulers were created, and how often its DrainBudget was used up. Returns empty metrics if they haven't been created yet, or have been shut down by SchedulerRegistry.
+    static DrainMetrics getMessageThreadMetrics();
+
+    /**
+        A scheduler with a virtual clock, which only advances when you call VirtualTimeScheduler::advanceBy. Pass it to the time-based operators (like Observable::debounce) and to Observable::observeOn to test or benchmark them deterministically, without waiting.
+
+        @see VirtualTimeScheduler
+     */
+    static VirtualTimeScheduler virtualTime();
+
+protected:
+    ///@cond INTERNAL
+    Scheduler(const std::shared_ptr<detail::SchedulerImpl>&);
+    ///@endcond
+
 private:
     template<typename T>
     friend class Observable;
     
     std::shared_ptr<detail::SchedulerImpl> impl;
-    Scheduler(const std::shared_ptr<detail::SchedulerImpl>&);
 
     JUCE_LEAK_DETECTOR(Scheduler)
 };
+
+/**
+    A Scheduler whose clock is advanced by hand. Actions run on the thread that calls advanceBy, when their due time has been reached. So time-based Observables behave the same on every run, and can be tested and benchmarked without waiting:
+
+        auto scheduler = Scheduler::virtualTime();
+        subject.debounce(RelativeTime::milliseconds(100), scheduler).subscribe(...);
+
+        subject.onNext(1);
+        scheduler.advanceBy(RelativeTime::milliseconds(99)); // Nothing emitted yet
+        scheduler.advanceBy(RelativeTime::milliseconds(1));  // Emits 1
+
+    Copies share the same clock. Keep a VirtualTimeScheduler alive while you use it: When the last copy is destroyed, pending actions are discarded.
+
+    Observable::observeOn with a bounded queue and OverflowStrategy::Block drops values instead of waiting, because the queue is only drained in advanceBy.
+ */
+class VirtualTimeScheduler : public Scheduler
+{
+public:
+    /// Creates a scheduler with its own clock, which starts at 0.
+    VirtualTimeScheduler();
+
+    /// Advances the clock, and runs all actions that are due until then (including actions that those actions schedule).
+    void advanceBy(const juce::RelativeTime& duration) const;
+
+    /// Returns the time that has passed on the clock since it was created.
+    juce::RelativeTime getNow() const;
+
+private:
+    std::shared_ptr<detail::VirtualClock> clock;
+
+    VirtualTimeScheduler(const std::shared_ptr<detail::VirtualClock>& clock);
+
+    JUCE_LEAK_DETECTOR(VirtualTimeScheduler)
+};
+
+/**
+    Controls the lifetime of the threads and the message thread dispatcher that Scheduler::messageThread, Scheduler::backgroundThread and Scheduler::newThread share across the process. So the number of threads stays the same, no matter how many plugin instances are loaded.
+
+    Give each plugin instance a SchedulerRegistry member. Declare it before the members that subscribe to Observables, so it's destroyed after them:
+
+        class MyProcessor : public AudioProcessor
+        {
+            SchedulerRegistry schedulerRegistry;
+            DisposeBag disposeBag;
+            ...
+        };
+
+    When the last SchedulerRegistry is destroyed, the shared threads are shut down and joined, and pending actions are discarded. So nothing of ReaX keeps running after the last plugin instance has been unloaded. If ReaX is used again afterwards, it starts new threads.
+
+    Don't create a SchedulerRegistry as a static or global variable: It would be destroyed during static destruction, where joining threads can deadlock.
+
+    Without any SchedulerRegistry, the shared threads are started when they are first needed, and are kept until the process ends. They aren't joined at exit. Pools created with Scheduler::threadPool are not shared, and end when they're not used anymore.
+ */
+class SchedulerRegistry
+{
+public:
+    /// Registers a user of the shared schedulers.
+    SchedulerRegistry();
+
+    /// If this is the last instance, shuts down the shared schedulers. Don't destroy it while Observables that use them are still subscribed.
+    ~SchedulerRegistry();
+
+    /// Returns the number of SchedulerRegistry instances that currently exist.
+    static int getNumInstances();
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SchedulerRegistry)
+};
+
+/**
+    Determines what Observable::observeOn does with a new value when its queue is full.
+
+    @see Observable::observeOn
+ */
+enum class OverflowStrategy
+{
+    /**
+        Waits until there is room in the queue. Don't use this on the audio thread.
+
+        Values that are emitted on the scheduler's own thread are dropped instead, because waiting there would never end. For Scheduler::backgroundThread and Scheduler::threadPool with more than one thread, that's only a value emitted while the same subscription is being observed on the pool. Other pool threads wait, so make sure the pool has a thread left to drain the queue.
+     */
+    Block,
+
+    /// Removes the oldest queued value, to make room for the new one.
+    DropOldest,
+
+    /// Drops the new value.
+    DropNewest,
+
+    /// Replaces the newest queued value with the new one, so the most recent value is always emitted. Use this if the latest state matters most, like for a level meter.
+    Latest
+};
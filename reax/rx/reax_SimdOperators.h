@@ -0,0 +1,117 @@
+#pragma once
+
+/**
+ Numeric operators for TypedObservables of `float` and `double`, which process whole batches with vectorized kernels (using `juce::FloatVectorOperations`).
+
+ They work best with sources that emit batches, like LockFreeSource::asTypedObservable or TypedObserver::onNextBatch. Single values are processed one at a time, without calling any std::function. Other arithmetic types use scalar fallbacks.
+
+ For example, a level meter for the samples from the audio thread, with one level per 1024 samples:
+
+     LockFreeSource<float> samples(4096);
+     simd::rms(simd::affine(samples.asTypedObservable(), gain), 1024)
+         .map([](float rms) { return Decibels::gainToDecibels(rms); })
+         .subscribe([&](float dB) { meter.setLevel(dB); })
+         .disposedBy(disposeBag);
+ */
+namespace simd {
+/**
+ Emits `value * multiplier + offset` for each value. Like `map`, but batches are transformed at once.
+ */
+template<typename T>
+TypedObservable<T> affine(const TypedObservable<T>& source, const typename TypedObservable<T>::ValueType& multiplier, const typename TypedObservable<T>::ValueType& offset = 0)
+{
+    static_assert(std::is_arithmetic<T>::value, "simd operators require an arithmetic type.");
+
+    return detail::simdLift(source, [multiplier, offset](const typename detail::PushObserver<T>::Ptr& downstream, const detail::PushSubscription::Ptr& subscription) {
+        return typename detail::PushObserver<T>::Ptr(new detail::SimdAffineObserver<T>(downstream, subscription, multiplier, offset));
+    });
+}
+
+/**
+ Emits the running sum of the values, beginning with `startValue`. Like `scan` with `+`, but batches are summed at once.
+ */
+template<typename T>
+TypedObservable<T> runningSum(const TypedObservable<T>& source, const typename TypedObservable<T>::ValueType& startValue = 0)
+{
+    static_assert(std::is_arithmetic<T>::value, "simd operators require an arithmetic type.");
+
+    return detail::simdLift(source, [startValue](const typename detail::PushObserver<T>::Ptr& downstream, const detail::PushSubscription::Ptr& subscription) {
+        return typename detail::PushObserver<T>::Ptr(new detail::SimdRunningSumObserver<T>(downstream, subscription, startValue));
+    });
+}
+
+/**
+ Emits the sum of all values when the source completes. Like `reduce` with `+`.
+ */
+template<typename T>
+TypedObservable<T> sum(const TypedObservable<T>& source)
+{
+    static_assert(std::is_arithmetic<T>::value, "simd operators require an arithmetic type.");
+
+    return detail::simdLift(source, [](const typename detail::PushObserver<T>::Ptr& downstream, const detail::PushSubscription::Ptr& subscription) {
+        return typename detail::PushObserver<T>::Ptr(new detail::SimdReduceObserver<T>(downstream, subscription, detail::SimdReduceObserver<T>::Kind::Sum));
+    });
+}
+
+/**
+ Emits the smallest value when the source completes. Doesn't emit anything if the source hasn't emitted any values.
+ */
+template<typename T>
+TypedObservable<T> minimum(const TypedObservable<T>& source)
+{
+    static_assert(std::is_arithmetic<T>::value, "simd operators require an arithmetic type.");
+
+    return detail::simdLift(source, [](const typename detail::PushObserver<T>::Ptr& downstream, const detail::PushSubscription::Ptr& subscription) {
+        return typename detail::PushObserver<T>::Ptr(new detail::SimdReduceObserver<T>(downstream, subscription, detail::SimdReduceObserver<T>::Kind::Minimum));
+    });
+}
+
+/**
+ Emits the largest value when the source completes. Doesn't emit anything if the source hasn't emitted any values.
+ */
+template<typename T>
+TypedObservable<T> maximum(const TypedObservable<T>& source)
+{
+    static_assert(std::is_arithmetic<T>::value, "simd operators require an arithmetic type.");
+
+    return detail::simdLift(source, [](const typename detail::PushObserver<T>::Ptr& downstream, const detail::PushSubscription::Ptr& subscription) {
+        return typename detail::PushObserver<T>::Ptr(new detail::SimdReduceObserver<T>(downstream, subscription, detail::SimdReduceObserver<T>::Kind::Maximum));
+    });
+}
+
+/**
+ Emits the peak level (the largest absolute value) of each window of `windowSize` consecutive values.
+
+ The windows only depend on the number of values, not on how they are batched, so the levels are the same however the values arrive. Values that don't fill a whole window when the source completes are not emitted.
+ */
+template<typename T>
+TypedObservable<T> peak(const TypedObservable<T>& source, size_t windowSize)
+{
+    static_assert(std::is_floating_point<T>::value, "peak requires a floating-point type.");
+
+    // The window size must be > 0.
+    jassert(windowSize > 0);
+
+    return detail::simdLift(source, [windowSize](const typename detail::PushObserver<T>::Ptr& downstream, const detail::PushSubscription::Ptr& subscription) {
+        return typename detail::PushObserver<T>::Ptr(new detail::SimdLevelObserver<T>(downstream, subscription, detail::SimdLevelObserver<T>::Kind::Peak, juce::jmax<size_t>(1, windowSize)));
+    });
+}
+
+/**
+ Emits the RMS level (the root mean square) of each window of `windowSize` consecutive values.
+
+ The windows only depend on the number of values, not on how they are batched, so the levels are the same however the values arrive. Values that don't fill a whole window when the source completes are not emitted.
+ */
+template<typename T>
+TypedObservable<T> rms(const TypedObservable<T>& source, size_t windowSize)
+{
+    static_assert(std::is_floating_point<T>::value, "rms requires a floating-point type.");
+
+    // The window size must be > 0.
+    jassert(windowSize > 0);
+
+    return detail::simdLift(source, [windowSize](const typename detail::PushObserver<T>::Ptr& downstream, const detail::PushSubscription::Ptr& subscription) {
+        return typename detail::PushObserver<T>::Ptr(new detail::SimdLevelObserver<T>(downstream, subscription, detail::SimdLevelObserver<T>::Kind::RMS, juce::jmax<size_t>(1, windowSize)));
+    });
+}
+}
@@ -51,6 +51,8 @@ private:
 /**
  A subject that initially doesn't have a value. It does not emit a value on subscribe, and emits only those values that are passed to onNext *after the time of the subscription*.
  
+ `T` may be a move-only type (like `std::unique_ptr<AudioBuffer<float>>`). Each value is moved in once, and all subscribers get a `const T&` to it.
+ 
  For an introduction to Subjects, please refer to http://reactivex.io/documentation/subject.html.
  */
 template<typename T>
@@ -4,7 +4,17 @@ Subscription::Subscription(detail::any&& wrapped)
 
 void Subscription::unsubscribe() const
 {
-    wrapped.get<rxcpp::subscription>().unsubscribe();
+    if (wrapped.is<detail::PushSubscription::Ptr>())
+        wrapped.get<detail::PushSubscription::Ptr>()->unsubscribe();
+    else
+        wrapped.get<rxcpp::subscription>().unsubscribe();
+}
+
+void Subscription::request(unsigned int numValues) const
+{
+    // rxcpp subscriptions don't support flow control
+    if (wrapped.is<detail::PushSubscription::Ptr>())
+        wrapped.get<detail::PushSubscription::Ptr>()->request(numValues);
 }
 
 void Subscription::disposedBy(DisposeBag& disposeBag)
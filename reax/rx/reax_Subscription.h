@@ -23,6 +23,11 @@ public:
     /// Unsubscribes from the Observable.
     void unsubscribe() const;
 
+    /**
+        Requests more values from an Observable that has been subscribed with Observable::subscribeWithDemand. Does nothing for other Subscriptions.
+     */
+    void request(unsigned int numValues) const;
+
     /**
         Moves the Subscription into a given DisposeBag. The Subscription is unsubscribed automatically when the DisposeBag is destroyed.
      
@@ -35,6 +40,8 @@ public:
 private:
     friend struct detail::ObservableImpl;
     friend class DisposeBag;
+    template<typename T>
+    friend class TypedObservable;
     
     detail::any wrapped;
 
@@ -0,0 +1,511 @@
+#pragma once
+
+template<typename T>
+class TypedObservable;
+
+namespace detail {
+struct TypedObservableAccess;
+
+// An observer that unboxes each value and passes it on to a PushObserver. Batches are unboxed into a reused buffer, and passed on as one batch.
+template<typename T>
+class PushUnboxingObserver : public PushObserver<any>
+{
+public:
+    explicit PushUnboxingObserver(const typename PushObserver<T>::Ptr& observer)
+    : observer(observer)
+    {}
+
+    void onNext(const any& value) override
+    {
+        observer->onNext(value.get<T>());
+    }
+
+    void onNextBatch(const any* values, size_t numValues) override
+    {
+        unboxBatch(values, numValues, std::is_copy_constructible<T>());
+    }
+
+    void onError(std::exception_ptr error) override
+    {
+        observer->onError(error);
+    }
+
+    void onCompleted() override
+    {
+        observer->onCompleted();
+    }
+
+private:
+    const typename PushObserver<T>::Ptr observer;
+    juce::Array<T> storage;
+
+    void unboxBatch(const any* values, size_t numValues, std::true_type)
+    {
+        // Take the storage, in case the observer emits into this one again
+        juce::Array<T> unboxed(std::move(storage));
+        unboxed.clearQuick();
+        unboxed.ensureStorageAllocated(static_cast<int>(numValues));
+
+        for (size_t i = 0; i < numValues; i++)
+            unboxed.add(values[i].get<T>());
+
+        observer->onNextBatch(unboxed.begin(), numValues);
+
+        unboxed.clearQuick();
+        storage = std::move(unboxed);
+    }
+
+    // Move-only values can't be copied into a contiguous span, so they are passed on one at a time
+    void unboxBatch(const any* values, size_t numValues, std::false_type)
+    {
+        PushObserver<any>::onNextBatch(values, numValues);
+    }
+};
+
+// A source that subscribes to a (boxed) Observable, and unboxes its values
+template<typename T>
+class PushObservableSource : public PushSource<T>
+{
+public:
+    explicit PushObservableSource(const ObservableImpl& observable)
+    : observable(observable)
+    {}
+
+    void subscribe(const typename PushObserver<T>::Ptr& observer, const PushSubscription::Ptr& subscription) override
+    {
+        const PushObserverHandle<any> handle{ new PushUnboxingObserver<T>(observer), subscription };
+        observable.subscribe(ObserverImpl(any(handle)));
+    }
+
+private:
+    const ObservableImpl observable;
+};
+
+// An observer that boxes each value and passes it on to an ObserverImpl
+template<typename T>
+class PushBoxingObserver : public PushObserver<T>
+{
+public:
+    explicit PushBoxingObserver(const ObserverImpl& observer)
+    : observer(observer)
+    {}
+
+    void onNext(const T& value) override
+    {
+        observer.onNext(any(value));
+    }
+
+    // Boxes the whole span into a reused buffer, and passes it on as one batch
+    void onNextBatch(const T* values, size_t numValues) override
+    {
+        // Take the storage, in case the observer emits into this one again
+        juce::Array<any> boxed(std::move(storage));
+        boxed.clearQuick();
+        boxed.ensureStorageAllocated(static_cast<int>(numValues));
+
+        for (size_t i = 0; i < numValues; i++)
+            boxed.add(any(values[i]));
+
+        observer.onNextBatch(boxed.begin(), numValues);
+
+        boxed.clearQuick();
+        storage = std::move(boxed);
+    }
+
+    void onError(std::exception_ptr error) override
+    {
+        observer.onError(error);
+    }
+
+    void onCompleted() override
+    {
+        observer.onCompleted();
+    }
+
+private:
+    const ObserverImpl observer;
+    juce::Array<any> storage;
+};
+}
+
+/**
+ Retrieves values for a TypedObservable. You can call onNext to notify the TypedObserver with a new value.
+
+ @see TypedObservable::create, TypedPublishSubject
+ */
+template<typename T>
+class TypedObserver
+{
+public:
+    /// Notifies the TypedObserver with a new value.
+    void onNext(const T& value) const
+    {
+        impl->onNext(value);
+    }
+
+    /**
+     Notifies the TypedObserver with a span of values at once.
+
+     Operators that support batches (`map`, `filter`, `scan`, `skip`, `take` and `takeWhile`) process the whole span at once, and pass it on as a single batch. Subscribers that don't support batches receive the values one at a time.
+     */
+    void onNextBatch(const T* values, size_t numValues) const
+    {
+        impl->onNextBatch(values, numValues);
+    }
+
+    /// Notifies the TypedObserver that an error has occurred.
+    void onError(std::exception_ptr error) const
+    {
+        impl->onError(error);
+    }
+
+    /// Notifies the TypedObserver that no more values will be pushed.
+    void onCompleted() const
+    {
+        impl->onCompleted();
+    }
+
+    /**
+     Returns true if the subscriber has unsubscribed (or an operator like `take` has ended the subscription), so values passed to onNext aren't needed anymore.
+
+     Long-running producers in TypedObservable::create should check this, and stop emitting. Always returns false for a TypedPublishSubject.
+     */
+    bool isUnsubscribed() const
+    {
+        return (subscription != nullptr && subscription->isUnsubscribed());
+    }
+
+protected:
+    ///@cond INTERNAL
+    explicit TypedObserver(const typename detail::PushObserver<T>::Ptr& impl, const detail::PushSubscription::Ptr& subscription = nullptr)
+    : impl(impl),
+      subscription(subscription)
+    {}
+    ///@endcond
+
+private:
+    template<typename U>
+    friend class TypedObservable;
+
+    const typename detail::PushObserver<T>::Ptr impl;
+    const detail::PushSubscription::Ptr subscription;
+
+    JUCE_LEAK_DETECTOR(TypedObserver)
+};
+
+/**
+ An Observable that is typed end to end. Values are passed from operator to operator as `const T&`, without being boxed, and operator functions are called directly (they can be inlined by the compiler).
+
+ Values can also be emitted in batches (see TypedObserver::onNextBatch). `map`, `filter`, `scan`, `skip`, `take` and `takeWhile` process a batch as one contiguous span, and subscribeBatches receives it as a whole.
+
+ Use it for hot pipelines, like streams of `float` from a LockFreeSource. It supports the synchronous operators natively. `observeOn`, `observeOnLatest`, `debounce` and `sample` are available too, but go through a regular Observable (which boxes each value). For any operator that isn't listed here (like `combineLatest`), call `asObservable()` and use the regular Observable. You can convert back using `TypedObservable(const Observable<T>&)`.
+
+ For example:
+
+     LockFreeSource<float> levels(128);
+     levels.asTypedObservable()
+         .map([](float level) { return Decibels::gainToDecibels(level); })
+         .filter([](float dB) { return dB > -60.f; })
+         .subscribe([&](float dB) { meter.setLevel(dB); })
+         .disposedBy(disposeBag);
+ */
+template<typename T>
+class TypedObservable
+{
+    typedef detail::ObservableImpl Impl;
+    typedef typename detail::PushSource<T>::Ptr Source;
+
+public:
+#pragma mark - Helpers
+    /// The type of values emitted by this TypedObservable.
+    typedef T ValueType;
+
+    /// \cond internal
+    template<typename Function, typename... Args>
+    using CallResult = typename std::decay<typename std::result_of<Function(Args...)>::type>::type;
+    /// \endcond
+
+#pragma mark - Creation
+    /**
+     Creates a TypedObservable that doesn't emit any values and notifies onComplete immediately.
+     */
+    TypedObservable()
+    : source(new detail::PushTerminalSource<T>(detail::PushTerminalSource<T>::Kind::Empty))
+    {}
+
+    /**
+     Creates a TypedObservable that emits the values from a regular Observable. Each value is unboxed once, when it enters the TypedObservable.
+     */
+    explicit TypedObservable(const Observable<T>& observable)
+    : source(new detail::PushObservableSource<T>(observable.impl))
+    {}
+
+    /**
+     Creates a TypedObservable which emits values from a TypedObserver on each subscription.
+
+     In the onSubscribe function, you get a TypedObserver. You can call TypedObserver::onNext on it to emit values. Use TypedObserver::isUnsubscribed to find out when the subscription has ended, and stop emitting then.
+     */
+    static TypedObservable<T> create(const std::function<void(const TypedObserver<T>&)>& onSubscribe)
+    {
+        return Source(new detail::PushCreateSource<T>([onSubscribe](const typename detail::PushObserver<T>::Ptr& observer, const detail::PushSubscription::Ptr& subscription) {
+            onSubscribe(TypedObserver<T>(observer, subscription));
+        }));
+    }
+
+    /**
+     Creates a TypedObservable that doesn't emit any values and notifies onComplete immediately.
+     */
+    static TypedObservable<T> empty()
+    {
+        return TypedObservable<T>();
+    }
+
+    /**
+     Creates a TypedObservable which doesn't emit any values, and immediately notifies onError.
+     */
+    static TypedObservable<T> error(const std::exception& error)
+    {
+        return Source(new detail::PushTerminalSource<T>(detail::PushTerminalSource<T>::Kind::Error, std::make_exception_ptr(error)));
+    }
+
+    /**
+     Creates a TypedObservable that immediately emits the values from the given Array.
+     */
+    static TypedObservable<T> from(const juce::Array<T>& array)
+    {
+        return Source(new detail::PushFromSource<T>(juce::Array<T>(array)));
+    }
+
+    /**
+     Creates a TypedObservable which emits a single value.
+
+     The value is emitted immediately on each new subscription.
+     */
+    static TypedObservable<T> just(const T& value)
+    {
+        return from({ value });
+    }
+
+    /**
+     Creates a TypedObservable that never emits any events and never terminates.
+     */
+    static TypedObservable<T> never()
+    {
+        return Source(new detail::PushTerminalSource<T>(detail::PushTerminalSource<T>::Kind::Never));
+    }
+
+
+#pragma mark - Subscription
+    ///@{
+    /**
+     Subscribes to the TypedObservable, to receive values it emits. Works like Observable::subscribe.
+     */
+    Subscription subscribe(const std::function<void(const T&)>& onNext,
+                           const std::function<void(std::exception_ptr)>& onError = Impl::TerminateOnError,
+                           const std::function<void()>& onCompleted = Impl::EmptyOnCompleted) const
+    {
+        const auto subscription = detail::pushSubscribe<T>(source, onNext, onError, onCompleted);
+
+        return Subscription(detail::any(subscription));
+    }
+
+    /**
+     Subscribes to the TypedObservable with a function that receives spans of values.
+
+     Values that are emitted as a batch (for example from TypedObserver::onNextBatch or LockFreeSource) are passed to `onNextBatch` at once. Single values are passed as spans of one value.
+     */
+    Subscription subscribeBatches(const std::function<void(const T*, size_t)>& onNextBatch,
+                                  const std::function<void(std::exception_ptr)>& onError = Impl::TerminateOnError,
+                                  const std::function<void()>& onCompleted = Impl::EmptyOnCompleted) const
+    {
+        const auto subscription = detail::pushSubscribeBatches<T>(source, onNextBatch, onError, onCompleted);
+
+        return Subscription(detail::any(subscription));
+    }
+
+    /**
+     Subscribes a TypedObserver (for example a TypedPublishSubject) to the TypedObservable.
+     */
+    Subscription subscribe(const TypedObserver<T>& observer) const
+    {
+        const auto impl = observer.impl;
+        const detail::PushSubscription::Ptr subscription(new detail::PushSubscription());
+        source->subscribe(impl, subscription);
+
+        return Subscription(detail::any(subscription));
+    }
+
+    /**
+     Subscribes a regular Observer to the TypedObservable. Each value is boxed once, when it leaves the TypedObservable.
+
+     This lets you bind a TypedObservable to the reactive GUI extensions, like `Reactive<Label>::rx.text`.
+     */
+    template<typename U>
+    Subscription subscribe(const Observer<U>& observer, typename std::enable_if<std::is_convertible<T, U>::value>::type* = 0) const
+    {
+        return asObservable().subscribe(observer);
+    }
+    ///@}
+
+
+#pragma mark - Operators
+    /**
+     Returns a TypedObservable which emits the same values as this TypedObservable, but suppresses consecutive duplicate values. @see Observable::distinctUntilChanged
+     */
+    template<typename Equals = std::equal_to<T>>
+    TypedObservable<T> distinctUntilChanged(const Equals& equals = Equals()) const
+    {
+        return detail::pushDistinctUntilChanged<T>(source, equals);
+    }
+
+    /**
+     Returns a TypedObservable that emits only those values from this TypedObservable that pass a predicate function.
+     */
+    template<typename Predicate>
+    TypedObservable<T> filter(Predicate&& predicate) const
+    {
+        return detail::pushFilter<T>(source, typename std::decay<Predicate>::type(std::forward<Predicate>(predicate)));
+    }
+
+    /**
+     For each value emitted by this TypedObservable, call the function with that value and emit the result.
+     */
+    template<typename Function>
+    TypedObservable<CallResult<Function, const T&>> map(Function&& function) const
+    {
+        return detail::pushMap<CallResult<Function, const T&>, T>(source, typename std::decay<Function>::type(std::forward<Function>(function)));
+    }
+
+    /**
+     Begins with a `startValue`, and then applies `f` to all values emitted by this TypedObservable, and emits the aggregate result when this TypedObservable completes. @see Observable::reduce
+     */
+    template<typename Function>
+    TypedObservable<T> reduce(const T& startValue, Function&& function) const
+    {
+        return detail::pushScan<T>(source, startValue, typename std::decay<Function>::type(std::forward<Function>(function)), false);
+    }
+
+    /**
+     Emits the accumulated result of calling `f` with the accumulator and each value. The first parameter to `f` is the accumulator, the second is the current value. @see Observable::scan
+     */
+    template<typename Function>
+    TypedObservable<T> scan(const T& startValue, Function&& function) const
+    {
+        return detail::pushScan<T>(source, startValue, typename std::decay<Function>::type(std::forward<Function>(function)));
+    }
+
+    /**
+     Returns a TypedObservable which suppresses emitting the first `numValues` values from this TypedObservable.
+     */
+    TypedObservable<T> skip(unsigned int numValues) const
+    {
+        return detail::pushSkip<T>(source, numValues);
+    }
+
+    /**
+     Returns a TypedObservable that emits only the first `numValues` values from this TypedObservable.
+     */
+    TypedObservable<T> take(unsigned int numValues) const
+    {
+        return detail::pushTake<T>(source, numValues);
+    }
+
+    /**
+     Emits values from the beginning of this TypedObservable as long as the given `predicate` returns `true`.
+     */
+    template<typename Predicate>
+    TypedObservable<T> takeWhile(Predicate&& predicate) const
+    {
+        return detail::pushTakeWhile<T>(source, typename std::decay<Predicate>::type(std::forward<Predicate>(predicate)));
+    }
+
+
+#pragma mark - Scheduling
+    /**
+     Returns a TypedObservable that will be observed on a specified scheduler. @see Observable::observeOn
+
+     Values are boxed while they cross to the other thread.
+     */
+    TypedObservable<T> observeOn(const Scheduler& scheduler) const
+    {
+        return TypedObservable<T>(asObservable().observeOn(scheduler));
+    }
+
+    /**
+     Returns a TypedObservable that will be observed on a specified scheduler, emitting only the latest value per dispatch. @see Observable::observeOnLatest
+     */
+    TypedObservable<T> observeOnLatest(const Scheduler& scheduler) const
+    {
+        return TypedObservable<T>(asObservable().observeOnLatest(scheduler));
+    }
+
+    /**
+     Returns a TypedObservable which emits if `interval` has passed without this TypedObservable emitting a value. @see Observable::debounce
+     */
+    TypedObservable<T> debounce(const juce::RelativeTime& interval) const
+    {
+        return TypedObservable<T>(asObservable().debounce(interval));
+    }
+
+    /**
+     Returns a TypedObservable which emits the latest value from this TypedObservable every `interval`, if it has emitted a new value. @see Observable::sample
+     */
+    TypedObservable<T> sample(const juce::RelativeTime& interval) const
+    {
+        return TypedObservable<T>(asObservable().sample(interval));
+    }
+
+
+#pragma mark - Misc
+    /**
+     Returns a regular Observable that emits the values from this TypedObservable. Each value is boxed once, when it leaves the TypedObservable.
+     */
+    Observable<T> asObservable() const
+    {
+        const Source source = this->source;
+
+        return Impl::create([source](detail::ObserverImpl&& observer) {
+            const detail::PushSubscription::Ptr subscription(new detail::PushSubscription());
+            observer.addTeardown([subscription]() { subscription->unsubscribe(); });
+            source->subscribe(new detail::PushBoxingObserver<T>(observer), subscription);
+        });
+    }
+
+private:
+    template<typename U>
+    friend class TypedObservable;
+    template<typename U>
+    friend class TypedPublishSubject;
+    friend struct detail::TypedObservableAccess;
+
+    Source source;
+
+    TypedObservable(const Source& source)
+    : source(source)
+    {}
+
+    JUCE_LEAK_DETECTOR(TypedObservable)
+};
+
+/**
+ A TypedObserver and TypedObservable in one. Pushing a value to its TypedObserver side causes the TypedObservable side to emit that value to all current subscribers.
+
+ This is the typed equivalent of PublishSubject.
+ */
+template<typename T>
+class TypedPublishSubject : public TypedObserver<T>, public TypedObservable<T>
+{
+public:
+    /// Creates a new instance.
+    TypedPublishSubject()
+    : TypedPublishSubject(new detail::PushSubject<T>())
+    {}
+
+private:
+    explicit TypedPublishSubject(const typename detail::PushSubject<T>::Ptr& subject)
+    : TypedObserver<T>(new detail::PushSubjectObserver<T>(subject)),
+      TypedObservable<T>(typename detail::PushSource<T>::Ptr(subject.get()))
+    {}
+
+    JUCE_LEAK_DETECTOR(TypedPublishSubject)
+};
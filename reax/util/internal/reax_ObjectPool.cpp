@@ -0,0 +1,217 @@
+namespace detail {
+namespace {
+    // The smallest block size. Size classes are MinBlockSize, 2 * MinBlockSize, 4 * MinBlockSize, … up to ObjectPool::MaxBlockSize.
+    const size_t MinBlockSize = 32;
+    const int NumSizeClasses = 6;
+    static_assert((MinBlockSize << (NumSizeClasses - 1)) == ObjectPool::MaxBlockSize, "The largest size class must be MaxBlockSize.");
+    static_assert(MinBlockSize % alignof(std::max_align_t) == 0, "Blocks must be aligned like std::max_align_t.");
+
+    // The number of blocks that a thread takes from (or gives back to) the shared pool at once
+    const size_t BatchSize = 32;
+
+    int getSizeClass(size_t size)
+    {
+        int sizeClass = 0;
+        for (size_t blockSize = MinBlockSize; blockSize < size; blockSize *= 2)
+            sizeClass++;
+
+        return sizeClass;
+    }
+
+    size_t getBlockSize(int sizeClass)
+    {
+        return (MinBlockSize << sizeClass);
+    }
+
+    // A free block stores a pointer to the next free block
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    // Free blocks that are shared between threads. Threads take and return them in batches, so the locks are rarely contended.
+    class SharedPool
+    {
+    public:
+        // Takes up to BatchSize blocks. Allocates new blocks if the pool is empty.
+        FreeBlock* take(int sizeClass, size_t& numTaken)
+        {
+            FreeBlock* first = nullptr;
+            numTaken = 0;
+
+            {
+                const SpinLock::ScopedLockType lock(locks[sizeClass]);
+                first = freeLists[sizeClass];
+                FreeBlock* last = nullptr;
+
+                for (FreeBlock* block = first; block != nullptr && numTaken < BatchSize; block = block->next) {
+                    last = block;
+                    numTaken++;
+                }
+
+                if (last != nullptr) {
+                    freeLists[sizeClass] = last->next;
+                    last->next = nullptr;
+                }
+            }
+
+            if (numTaken > 0)
+                return first;
+
+            FreeBlock* last = nullptr;
+            numTaken = BatchSize;
+            return allocateBlocks(sizeClass, BatchSize, last);
+        }
+
+        // Gives back a list of blocks, from first to last
+        void give(int sizeClass, FreeBlock* first, FreeBlock* last)
+        {
+            const SpinLock::ScopedLockType lock(locks[sizeClass]);
+            last->next = freeLists[sizeClass];
+            freeLists[sizeClass] = first;
+        }
+
+        void reserve(size_t numBlocks)
+        {
+            if (numBlocks == 0)
+                return;
+
+            for (int sizeClass = 0; sizeClass < NumSizeClasses; sizeClass++) {
+                FreeBlock* last = nullptr;
+                FreeBlock* const first = allocateBlocks(sizeClass, numBlocks, last);
+                give(sizeClass, first, last);
+            }
+        }
+
+    private:
+        SpinLock locks[NumSizeClasses];
+        FreeBlock* freeLists[NumSizeClasses] = {};
+
+        // Allocates a chunk of numBlocks blocks, and links them into a list. Returns the first block, and assigns the last one to `last`.
+        static FreeBlock* allocateBlocks(int sizeClass, size_t numBlocks, FreeBlock*& last)
+        {
+            const size_t blockSize = getBlockSize(sizeClass);
+            char* const chunk = static_cast<char*>(::operator new(numBlocks * blockSize));
+            FreeBlock* next = nullptr;
+
+            // Link the blocks from back to front
+            for (size_t i = numBlocks; i > 0; i--) {
+                FreeBlock* const block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * blockSize);
+                block->next = next;
+                next = block;
+
+                if (i == numBlocks)
+                    last = block;
+            }
+
+            return next;
+        }
+    };
+
+    SharedPool& getSharedPool()
+    {
+        // Never destroyed, because threads may give back blocks after static objects have been destroyed
+        static SharedPool* const pool = new SharedPool();
+        return *pool;
+    }
+
+    // The free blocks of a single thread. Allocating and deallocating doesn't need a lock, unless the cache is empty (or too full).
+    class ThreadCache
+    {
+    public:
+        ~ThreadCache();
+
+        void* allocate(int sizeClass)
+        {
+            if (freeLists[sizeClass] == nullptr)
+                freeLists[sizeClass] = getSharedPool().take(sizeClass, numFree[sizeClass]);
+
+            FreeBlock* const block = freeLists[sizeClass];
+            freeLists[sizeClass] = block->next;
+            numFree[sizeClass]--;
+
+            return block;
+        }
+
+        void deallocate(void* block, int sizeClass)
+        {
+            FreeBlock* const freeBlock = static_cast<FreeBlock*>(block);
+            freeBlock->next = freeLists[sizeClass];
+            freeLists[sizeClass] = freeBlock;
+            numFree[sizeClass]++;
+
+            // Give a batch back to the shared pool, so blocks that are allocated on one thread and freed on another don't pile up
+            if (numFree[sizeClass] >= 2 * BatchSize)
+                giveBack(sizeClass, BatchSize);
+        }
+
+    private:
+        FreeBlock* freeLists[NumSizeClasses] = {};
+        size_t numFree[NumSizeClasses] = {};
+
+        void giveBack(int sizeClass, size_t numBlocks)
+        {
+            FreeBlock* const first = freeLists[sizeClass];
+            FreeBlock* last = first;
+
+            for (size_t i = 1; i < numBlocks; i++)
+                last = last->next;
+
+            freeLists[sizeClass] = last->next;
+            numFree[sizeClass] -= numBlocks;
+            getSharedPool().give(sizeClass, first, last);
+        }
+    };
+
+    // Trivially destructible, so it can still be read while other thread_local objects are destroyed
+    thread_local bool threadCacheDestroyed = false;
+    thread_local ThreadCache threadCache;
+
+    ThreadCache::~ThreadCache()
+    {
+        for (int sizeClass = 0; sizeClass < NumSizeClasses; sizeClass++) {
+            if (numFree[sizeClass] > 0)
+                giveBack(sizeClass, numFree[sizeClass]);
+        }
+
+        threadCacheDestroyed = true;
+    }
+}
+
+void* ObjectPool::allocate(size_t size)
+{
+    if (size > MaxBlockSize)
+        return ::operator new(size);
+
+    const int sizeClass = getSizeClass(size);
+
+    // While the thread is exiting, allocate blocks individually. They are still pooled when they are deallocated.
+    if (threadCacheDestroyed)
+        return ::operator new(getBlockSize(sizeClass));
+
+    return threadCache.allocate(sizeClass);
+}
+
+void ObjectPool::deallocate(void* block, size_t size) noexcept
+{
+    if (size > MaxBlockSize) {
+        ::operator delete(block);
+        return;
+    }
+
+    const int sizeClass = getSizeClass(size);
+
+    if (threadCacheDestroyed) {
+        FreeBlock* const freeBlock = static_cast<FreeBlock*>(block);
+        getSharedPool().give(sizeClass, freeBlock, freeBlock);
+        return;
+    }
+
+    threadCache.deallocate(block, sizeClass);
+}
+
+void ObjectPool::reserve(size_t numBlocks)
+{
+    getSharedPool().reserve(numBlocks);
+}
+}
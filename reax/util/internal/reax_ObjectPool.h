@@ -0,0 +1,71 @@
+#pragma once
+
+namespace detail {
+/**
+ A pool of memory blocks for the objects that `any` stores on the heap.
+
+ Blocks are grouped into size classes (powers of two, up to MaxBlockSize bytes). Each thread has its own cache of free blocks, so most allocations and deallocations don't need a lock. Threads move blocks between their cache and a shared pool in batches. Larger blocks are allocated with the global operator new.
+
+ The pool grows on demand, and never gives memory back to the system.
+ */
+///@cond INTERNAL
+class ObjectPool
+{
+public:
+    /// Blocks larger than this are not pooled.
+    static const size_t MaxBlockSize = 1024;
+
+    /// Returns a block of at least `size` bytes, aligned like std::max_align_t.
+    static void* allocate(size_t size);
+
+    /// Returns a block to the pool. The `size` must be the same that was passed to allocate().
+    static void deallocate(void* block, size_t size) noexcept;
+
+    /// Adds `numBlocks` free blocks to the shared pool, for each size class.
+    static void reserve(size_t numBlocks);
+};
+
+/// An allocator that uses the ObjectPool. Used with `std::allocate_shared`.
+template<typename T>
+class PoolAllocator
+{
+public:
+    typedef T value_type;
+
+    PoolAllocator() noexcept {}
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept
+    {}
+
+    T* allocate(size_t n)
+    {
+        // The pool only guarantees the alignment of std::max_align_t
+        if (alignof(T) > alignof(std::max_align_t))
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+
+        return static_cast<T*>(ObjectPool::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* block, size_t n) noexcept
+    {
+        if (alignof(T) > alignof(std::max_align_t))
+            ::operator delete(block);
+        else
+            ObjectPool::deallocate(block, n * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept
+    {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const PoolAllocator<U>&) const noexcept
+    {
+        return false;
+    }
+};
+///@endcond
+}
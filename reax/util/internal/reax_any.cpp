@@ -24,6 +24,43 @@ any::any(double value)
   doubleValue(value)
 {}
 
+any::any(any&& other) noexcept
+: type(other.type),
+  objectValue(std::move(other.objectValue))
+{
+    moveValueFrom(other);
+}
+
+any::any(const any& other)
+: type(other.type),
+  objectValue(other.objectValue)
+{
+    copyValueFrom(other);
+}
+
+any& any::operator=(any&& other) noexcept
+{
+    if (this != &other) {
+        destroyInlineObject();
+        type = other.type;
+        objectValue = std::move(other.objectValue);
+        moveValueFrom(other);
+    }
+
+    return *this;
+}
+
+any& any::operator=(const any& other)
+{
+    // Copy first, so this instance is left untouched if copying the wrapped object throws
+    return (*this = any(other));
+}
+
+any::~any()
+{
+    destroyInlineObject();
+}
+
 bool any::equals(const any& other) const
 {
     if (isArithmetic() != other.isArithmetic())
@@ -45,13 +82,14 @@ bool any::equals(const any& other) const
         case Type::RawPointer:
             return (other.type == Type::RawPointer && rawPointerValue == other.rawPointerValue);
         case Type::Object:
-            return objectValue->equals(*other.objectValue);
+        case Type::InlineObject:
+            return (other.getObject() != nullptr && getObject()->equals(*other.getObject()));
     }
 }
 
 bool any::isArithmetic() const
 {
-    return (type != Type::Enum && type != Type::RawPointer && type != Type::Object);
+    return (type != Type::Enum && type != Type::RawPointer && type != Type::Object && type != Type::InlineObject);
 }
 
 std::string any::getTypeName() const
@@ -72,11 +110,35 @@ std::string any::getTypeName() const
         case Type::Enum:
             return "enum";
         case Type::Object:
-            return objectValue->typeInfo.name();
+        case Type::InlineObject:
+            return getObject()->typeInfo.name();
     }
 }
 
-any::Object::Object(const std::type_info& typeInfo)
-: typeInfo(typeInfo)
+void any::copyValueFrom(const any& other)
+{
+    if (type == Type::InlineObject)
+        other.getObject()->copyInto(&inlineStorage);
+    else
+        std::memcpy(&inlineStorage, &other.inlineStorage, sizeof(InlineStorage));
+}
+
+void any::moveValueFrom(any& other) noexcept
+{
+    if (type == Type::InlineObject)
+        const_cast<Object*>(other.getObject())->moveInto(&inlineStorage);
+    else
+        std::memcpy(&inlineStorage, &other.inlineStorage, sizeof(InlineStorage));
+}
+
+void any::destroyInlineObject() noexcept
+{
+    if (type == Type::InlineObject)
+        getObject()->~Object();
+}
+
+any::Object::Object(const std::type_info& typeInfo, const void* typeTag)
+: typeInfo(typeInfo),
+  typeTag(typeTag)
 {}
 }
@@ -2,7 +2,9 @@
 
 namespace detail {
 /**
- A dynamic wrapper that can hold a value of any copy-constructible type.
+ A dynamic wrapper that can hold a value of any copy- or move-constructible type.
+ 
+ Small objects (that are nothrow-move-constructible, copy-constructible and equality-comparable) are stored inline, so wrapping them doesn't allocate. Other objects are allocated on the heap (from the ObjectPool) and shared between copies. This includes move-only types like `std::unique_ptr`: They are moved onto the heap once, and never copied afterwards.
  
  The type of the held value is erased. So to extract the held value (using `any::get()`), you have to provide the exact type of the held value. No base-class, of it, but the exact type it was constructed from. If in doubt, use `static_cast` before passing the value to the `any` constructor, to ensure that it's stored as a certain type.
  
@@ -60,18 +62,25 @@ public:
      */
     template<typename T>
     explicit any(T&& value, typename std::enable_if<is_class<T>::value && !is_any<T>::value>::type* = 0)
-    : type(Type::Object),
-      objectValue(std::make_shared<EquatableTypedObject<typename std::decay<T>::type>>(std::forward<T>(value)))
-    {}
+    : type(Type::Object)
+    {
+        typedef typename std::decay<T>::type Decayed;
+        constructObject<Decayed>(std::forward<T>(value), std::integral_constant<bool, StoresInline<Decayed>::value>());
+    }
+
+    /// Move constructor. Objects that are stored inline are moved, other objects are transferred by reference.
+    any(any&& other) noexcept;
+
+    /// Copy constructor. If the wrapped value is scalar or stored inline, it is copied. Otherwise, it is shared by reference.
+    any(const any& other);
 
-    /// Default move constructor
-    any(any&&) = default;
+    /// Move assignment operator.
+    any& operator=(any&& other) noexcept;
 
-    /// Default copy constructor. If the wrapped value is scalar, it is copied. Otherwise, it is shared by reference.
-    any(const any&) = default;
+    /// Copy assignment operator. If the wrapped value is scalar or stored inline, it is copied. Otherwise, it is shared by reference.
+    any& operator=(const any& other);
 
-    /// Default copy assignment operator. If the wrapped value is scalar, it is copied. Otherwise, it is shared by reference.
-    any& operator=(const any&) = default;
+    ~any();
 
     ///@{
     /**
@@ -126,13 +135,50 @@ public:
     template<typename T>
     const T& get(typename std::enable_if<is_class<T>::value>::type* = 0) const
     {
-        if (!is<T>())
-            throw typeMismatchError<T>();
+        if (auto object = getObjectPointer<T>())
+            return object->t;
 
-        return getObjectPointer<T>()->t;
+        throw typeMismatchError<T>();
     }
     ///@}
 
+    /**
+     Extracts the held object as a `shared_ptr<const T>`. Throws an exception if the held value is not a T.
+     
+     If the object is on the heap, the returned pointer shares ownership with this instance (and its copies), so no copy is made. Small objects that are stored inline are copied into a new `shared_ptr`.
+     */
+    template<typename T>
+    std::shared_ptr<const T> getShared(typename std::enable_if<is_class<T>::value>::type* = 0) const
+    {
+        if (auto object = getObjectPointer<T>()) {
+            if (type == Type::Object)
+                return std::shared_ptr<const T>(objectValue, &object->t);
+
+            return copyShared(object->t, std::is_copy_constructible<T>());
+        }
+
+        throw typeMismatchError<T>();
+    }
+
+    /**
+     Moves the held object out of this instance, and returns it. Throws an exception if the held value is not a T.
+     
+     If the object is on the heap and shared with other instances, it's copied instead, so they are not affected. T must be copy-constructible.
+     */
+    template<typename T>
+    T take(typename std::enable_if<is_class<T>::value>::type* = 0)
+    {
+        auto object = const_cast<TypedObject<T>*>(getObjectPointer<T>());
+
+        if (object == nullptr)
+            throw typeMismatchError<T>();
+
+        if (type == Type::Object && objectValue.use_count() > 1)
+            return object->t;
+
+        return std::move(object->t);
+    }
+
     /**
      Checks whether the held value is a T. For class types, it returns true only if the wrapped type is exactly T, not a base class.
      */
@@ -170,14 +216,27 @@ public:
     bool equals(const any& other) const;
 
 private:
+    // Returns a unique tag for each type. Used to check the type of a wrapped object without RTTI.
+    template<typename T>
+    static const void* getTypeTag()
+    {
+        static const char tag = 0;
+        return &tag;
+    }
+
     // Type-erased wrapper
     struct Object
     {
-        Object(const std::type_info& typeInfo);
+        Object(const std::type_info& typeInfo, const void* typeTag);
         virtual ~Object() {}
         virtual bool equals(const Object& other) const = 0;
 
+        // Copy-/move-constructs this object into the given inline storage. Only called for objects that are stored inline.
+        virtual void copyInto(void* storage) const = 0;
+        virtual void moveInto(void* storage) noexcept = 0;
+
         const std::type_info& typeInfo;
+        const void* const typeTag;
     };
 
     // Object subclass that is also a T. It inherits from T to make this work: any(Derived()).get<Base>();
@@ -186,11 +245,36 @@ private:
     {
         template<typename U>
         TypedObject(U&& value)
-        : Object(typeid(U)),
+        : Object(typeid(T), getTypeTag<T>()),
           t(std::forward<U>(value))
         {}
 
+        void copyInto(void* storage) const override
+        {
+            copyInto(storage, std::integral_constant<bool, StoresInline<T>::value>());
+        }
+
+        void moveInto(void* storage) noexcept override
+        {
+            moveInto(storage, std::integral_constant<bool, StoresInline<T>::value>());
+        }
+
         T t;
+
+    private:
+        void copyInto(void* storage, std::true_type) const
+        {
+            new (storage) EquatableTypedObject<T>(t);
+        }
+
+        void moveInto(void* storage, std::true_type) noexcept
+        {
+            new (storage) EquatableTypedObject<T>(std::move(t));
+        }
+
+        // Objects on the heap are shared by reference, never copied or moved
+        void copyInto(void*, std::false_type) const { jassertfalse; }
+        void moveInto(void*, std::false_type) noexcept { jassertfalse; }
     };
 
     // Checks if T has operator==
@@ -219,7 +303,7 @@ private:
         bool equals(const Object& other) const override
         {
             // If other contains a T, compare them:
-            if (auto ptr = dynamic_cast<const EquatableTypedObject<T>*>(&other))
+            if (auto ptr = castObject<T, EquatableTypedObject<T>>(&other))
                 return (TypedObject<T>::t == ptr->t);
 
             // other does not contain a T, so the objects can't be equal
@@ -228,6 +312,22 @@ private:
         }
     };
 
+    template<typename T, typename Enable = void>
+    struct IsEquatable : std::false_type
+    {};
+
+    template<typename T>
+    struct IsEquatable<T, HasEqualityOperator<T>> : std::true_type
+    {};
+
+    // Storage for small objects, so they don't need a heap allocation. Large enough for common JUCE value types like Rectangle<int>, String or var.
+    typedef typename std::aligned_storage<6 * sizeof(void*), alignof(std::max_align_t)>::type InlineStorage;
+
+    // Checks if T is stored inline. Objects that are not equality-comparable are stored on the heap, so copies keep comparing equal by address.
+    template<typename T>
+    struct StoresInline : std::integral_constant<bool, (sizeof(EquatableTypedObject<T>) <= sizeof(InlineStorage) && alignof(EquatableTypedObject<T>) <= alignof(InlineStorage) && std::is_nothrow_move_constructible<T>::value && std::is_copy_constructible<T>::value && IsEquatable<T>::value)>
+    {};
+
     // The type of the held value. Needed to use the correct member of the union.
     enum class Type {
         Int,
@@ -237,12 +337,13 @@ private:
         Double,
         RawPointer,
         Enum,
-        Object
+        Object,
+        InlineObject
     };
 
     Type type;
 
-    // The held value, if it's scalar (including enums).
+    // The held value, if it's scalar (including enums), or a small object.
     union
     {
         int intValue;
@@ -252,11 +353,58 @@ private:
         double doubleValue;
         void* rawPointerValue;
         juce::int64 enumValue;
+        InlineStorage inlineStorage;
     };
 
-    // The held value, if it's non-scalar.
+    // The held value, if it's a non-scalar object that is not stored inline.
     std::shared_ptr<Object> objectValue;
 
+    template<typename T, typename U>
+    void constructObject(U&& value, std::true_type)
+    {
+        new (&inlineStorage) EquatableTypedObject<T>(std::forward<U>(value));
+        type = Type::InlineObject;
+    }
+
+    template<typename T, typename U>
+    void constructObject(U&& value, std::false_type)
+    {
+        objectValue = std::allocate_shared<EquatableTypedObject<T>>(PoolAllocator<EquatableTypedObject<T>>(), std::forward<U>(value));
+    }
+
+    // Returns the wrapped object, or nullptr if the held value is scalar.
+    const Object* getObject() const
+    {
+        switch (type) {
+            case Type::Object:
+                return objectValue.get();
+            case Type::InlineObject:
+                return reinterpret_cast<const Object*>(&inlineStorage);
+            default:
+                return nullptr;
+        }
+    }
+
+    template<typename T>
+    static std::shared_ptr<const T> copyShared(const T& t, std::true_type)
+    {
+        return std::make_shared<T>(t);
+    }
+
+    // Objects that aren't copy-constructible are never stored inline
+    template<typename T>
+    static std::shared_ptr<const T> copyShared(const T&, std::false_type)
+    {
+        jassertfalse;
+        return nullptr;
+    }
+
+    // Copies or moves the held value from other. Expects type and objectValue to be assigned already.
+    void copyValueFrom(const any& other);
+    void moveValueFrom(any& other) noexcept;
+
+    void destroyInlineObject() noexcept;
+
     template<typename T>
     std::runtime_error typeMismatchError() const
     {
@@ -264,10 +412,24 @@ private:
         return std::runtime_error("Error getting type from any. Requested: " + RequestedType + ". Actual: " + getTypeName() + ".");
     }
 
+    // Casts an Object to a TypedObject<T>, or returns nullptr if it doesn't hold exactly a T. Objects are always created as EquatableTypedObject<T>, so they can be cast to that, too.
+    template<typename T, typename TypedObjectType = TypedObject<T>>
+    static const TypedObjectType* castObject(const Object* object)
+    {
+        if (object == nullptr)
+            return nullptr;
+
+        // The type tags differ if the object was created in another shared library. Comparing the type_info (which compares the type names) still matches then.
+        if (object->typeTag == getTypeTag<T>() || object->typeInfo == typeid(T))
+            return static_cast<const TypedObjectType*>(object);
+
+        return nullptr;
+    }
+
     template<typename T>
     const TypedObject<T>* getObjectPointer() const
     {
-        return std::dynamic_pointer_cast<const TypedObject<T>>(objectValue).get();
+        return castObject<T>(getObject());
     }
 
     bool isArithmetic() const;
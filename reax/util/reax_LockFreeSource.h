@@ -1,10 +1,73 @@
 #pragma once
 
 namespace detail {
-template<typename T>
+// Emits copyable values without boxing them, through a TypedPublishSubject. Values are dequeued in bulk, and each block is emitted as one batch.
+// emitAll returns true if it has stopped because the DrainBudget was used up.
+template<typename T, bool IsCopyConstructible = std::is_copy_constructible<T>::value>
 class LockFreeSourceBase
 {
 protected:
+    LockFreeSourceBase(const T& dummy, size_t queueCapacity)
+    : dummy(dummy)
+    {
+        // Allocated here, so emitting doesn't allocate
+        batch.insertMultiple(0, dummy, static_cast<int>(juce::jlimit<size_t>(1, 256, queueCapacity)));
+    }
+
+    Observable<T> getObservable() const { return subject.asObservable(); }
+    TypedObservable<T> getTypedObservable() const { return subject; }
+    T makeDummy() const { return dummy; }
+
+    bool emitAll(moodycamel::ConcurrentQueue<T>& queue, DrainMeter& meter)
+    {
+        for (;;) {
+            const size_t maxValues = juce::jmin(static_cast<size_t>(batch.size()), static_cast<size_t>(meter.getRemainingItems()));
+            const size_t numValues = queue.try_dequeue_bulk(batch.begin(), maxValues);
+
+            if (numValues == 0)
+                return false;
+
+            subject.onNextBatch(batch.begin(), numValues);
+            meter.addItems(static_cast<int>(numValues));
+
+            if (meter.isExhausted())
+                return true;
+        }
+    }
+
+private:
+    TypedPublishSubject<T> subject;
+    const T dummy;
+    juce::Array<T> batch;
+};
+
+// Move-only values can't be boxed once per subscriber. So each value is moved into a single box, which all subscribers share.
+template<typename T>
+class LockFreeSourceBase<T, false>
+{
+protected:
+    LockFreeSourceBase(const T&, size_t) {}
+
+    Observable<T> getObservable() const { return subject; }
+    TypedObservable<T> getTypedObservable() const { return TypedObservable<T>(subject); }
+    T makeDummy() const { return T(); }
+
+    // Moves each value out of the queue, and into the Observable
+    bool emitAll(moodycamel::ConcurrentQueue<T>& queue, DrainMeter& meter)
+    {
+        T value;
+        while (queue.try_dequeue(value)) {
+            subject.onNext(std::move(value));
+            meter.addItems(1);
+
+            if (meter.isExhausted())
+                return true;
+        }
+
+        return false;
+    }
+
+private:
     PublishSubject<T> subject;
 };
 }
@@ -27,9 +90,11 @@ enum class CongestionPolicy {
 /**
  An Observable that receives values from a realtime thread (like the audio thread) and emits those values on the JUCE message thread.
  
- The value type must be copy-constructible or (preferably) move-constructible.
+ The value type must be copy-constructible or (preferably) move-constructible. Move-only types (like `std::unique_ptr<AudioBuffer<float>>`) are supported, too: Each value is moved through the queue, and all subscribers share it. A move-only type must be default-constructible, and the `dummy` is not used.
  
  Call asObservable() to get the Observable, subscribe to it, etc. Then call LockFreeSource::onNext on the realtime thread to emit values.
+
+ For hot pipelines (like metering), use asTypedObservable() instead. It emits the values without boxing them. Copyable values are taken from the queue in blocks, and each block is emitted as one batch (see TypedObservable::subscribeBatches).
  */
 template<typename T>
 class LockFreeSource : private detail::LockFreeSourceBase<T>, private juce::AsyncUpdater, public Observable<T>
@@ -41,9 +106,9 @@ public:
      The queueCapacity must be > 0. If you have to use CongestionPolicy::Allocate, use a large capacity, to make dynamic allocation on the audio thread as unlikely as possible. **The given `queueCapacity` may get rounded up to a different value.**
      */
     explicit LockFreeSource(size_t queueCapacity, const T& dummy = T())
-    : Observable<T>(detail::LockFreeSourceBase<T>::subject),
-      queue(queueCapacity),
-      dummy(dummy)
+    : detail::LockFreeSourceBase<T>(dummy, queueCapacity),
+      Observable<T>(detail::LockFreeSourceBase<T>::getObservable()),
+      queue(queueCapacity)
     {
         // The queue capacity must be > 0.
         jassert(queueCapacity > 0);
@@ -66,9 +131,33 @@ public:
     }
     ///@}
 
+    /**
+     Returns a TypedObservable that emits the values on the message thread. Unlike the Observable, it doesn't box the values.
+     */
+    TypedObservable<T> asTypedObservable() const
+    {
+        return detail::LockFreeSourceBase<T>::getTypedObservable();
+    }
+
+    /**
+     Limits how many values are emitted per callback on the message thread. By default, all queued values are emitted at once, which may block the message thread after a large burst. With a budget, the remaining values are emitted in the next callback.
+
+     Can be called on any thread. @see DrainBudget
+     */
+    void setDrainBudget(const DrainBudget& budget)
+    {
+        meter.setBudget(budget);
+    }
+
+    /// Returns how many values have been emitted so far, and how often the DrainBudget was used up.
+    DrainMetrics getDrainMetrics() const
+    {
+        return meter.getMetrics();
+    }
+
 private:
     moodycamel::ConcurrentQueue<T> queue;
-    T dummy;
+    detail::DrainMeter meter;
 
     template<typename U>
     void _onNext(U&& value, CongestionPolicy congestionPolicy)
@@ -90,15 +179,15 @@ private:
             // If the oldest value may be dropped, try to enqueue (without allocating), and remove the oldest value if needed.
             case CongestionPolicy::DropOldest: {
                 // Try to enqueue the value. If it succeeds, there's no need to copy the dummy.
-                // Cannot use std::forward here: Value must not be moved because try_enqueue may be called again (multiple times) below.
-                if (queue.try_enqueue(value)) {
+                // try_enqueue only moves from the value if it succeeds, so it's safe to call it again (multiple times) below.
+                if (queue.try_enqueue(std::forward<U>(value))) {
                     needsUpdate = true;
                     break;
                 }
                 
                 // Queue is full. Drop values from the front until there's space again:
-                T unused(dummy);
-                while (!queue.try_enqueue(value))
+                T unused(detail::LockFreeSourceBase<T>::makeDummy());
+                while (!queue.try_enqueue(std::forward<U>(value)))
                     queue.try_dequeue(unused);
                 
                 needsUpdate = true;
@@ -113,10 +202,13 @@ private:
 
     void handleAsyncUpdate() override
     {
-        // Emits all values from the queue
-        T value(dummy);
-        while (queue.try_dequeue(value))
-            detail::LockFreeSourceBase<T>::subject.onNext(value);
+        meter.beginCallback();
+
+        // Continue in the next callback, if values are left
+        if (detail::LockFreeSourceBase<T>::emitAll(queue, meter) && queue.size_approx() > 0) {
+            meter.recordExhausted();
+            triggerAsyncUpdate();
+        }
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LockFreeSource)
@@ -1,28 +1,88 @@
 #pragma once
 
 namespace detail {
-template<typename T>
+template<typename T, bool IsCopyConstructible = std::is_copy_constructible<T>::value>
 class LockFreeTargetBase
 {
 protected:
     LockFreeTargetBase()
     {
-        subject.subscribe([this](const T& newValue) {
-                   queue.enqueue(newValue);
-               })
+        // Values that are emitted as a batch are enqueued at once
+        TypedObservable<T>(subject).subscribeBatches([this](const T* values, size_t numValues) {
+                                       queue.enqueue_bulk(values, numValues);
+                                   })
             .disposedBy(disposeBag);
     }
 
+    template<typename U>
+    bool dequeue(U& value)
+    {
+        return queue.try_dequeue(value);
+    }
+
     moodycamel::ConcurrentQueue<T> queue;
     PublishSubject<T> subject;
     DisposeBag disposeBag;
 };
+
+// Move-only values can't be copied out of the Observable (it may have other subscribers). So the queue holds pointers that share them. A value can be moved out once the queue holds the only pointer to it.
+template<typename T>
+class LockFreeTargetBase<T, false>
+{
+protected:
+    LockFreeTargetBase()
+    {
+        subject.asSharedPointers().subscribe([this](const std::shared_ptr<const T>& newValue) {
+                                      queue.enqueue(newValue);
+                                  })
+            .disposedBy(disposeBag);
+    }
+
+    template<typename U>
+    bool dequeue(U& value)
+    {
+        // The held value is the oldest one
+        if (held != nullptr) {
+            value = std::move(held);
+            held = nullptr;
+            return true;
+        }
+
+        return queue.try_dequeue(value);
+    }
+
+    bool take(T& value)
+    {
+        if (held == nullptr && !queue.try_dequeue(held))
+            return false;
+
+        // The producer (or another subscriber) still shares the value. Keep it at the front, and try again in the next call.
+        if (held.use_count() > 1)
+            return false;
+
+        // The pointer is const only because other subscribers might share the value. No one does, so it can be moved.
+        value = std::move(const_cast<T&>(*held));
+        held = nullptr;
+        return true;
+    }
+
+    moodycamel::ConcurrentQueue<std::shared_ptr<const T>> queue;
+
+    // A dequeued value that tryTake couldn't move out yet
+    std::shared_ptr<const T> held;
+    PublishSubject<T> subject;
+    DisposeBag disposeBag;
+};
 }
 
 /**
  An `Observer` that puts all retrieved values in a lock-free queue. The queue can be accessed from another thread without locking.
  
  Useful to transfer data from a non-realtime thread to a realtime thread.
+ 
+ If `T` is move-only (like `std::unique_ptr<AudioBuffer<float>>`), the queue holds `std::shared_ptr<const T>`s, which share the values without copying them. Pass a `std::shared_ptr<const T>` to tryDequeue in that case, or call `tryTake` to move the value out of the queue if no one else shares it. Note that releasing the last pointer to a value destroys it, so avoid doing that on the realtime thread.
+ 
+ Values passed to `onNextBatch` (for copy-constructible `T`) are enqueued at once.
  */
 template<typename T>
 class LockFreeTarget : private detail::LockFreeTargetBase<T>, public Observer<T>
@@ -44,7 +104,20 @@ public:
     template<typename U>
     bool tryDequeue(U& value)
     {
-        return detail::LockFreeTargetBase<T>::queue.try_dequeue(value);
+        return detail::LockFreeTargetBase<T>::dequeue(value);
+    }
+
+    /**
+     Dequeues the next value and moves it into `value`, without copying it. Only for move-only `T`: Use this to take ownership of a value like a `std::unique_ptr<AudioBuffer<float>>`.
+     
+     The value can only be moved once the queue holds the only pointer to it. The producer releases its pointer shortly after the value has been enqueued (when its onNext call returns). Until then, it returns `false`, and keeps the value at the front of the queue for the next call, so no value is lost. If another subscriber keeps the value (e.g. a `ReplaySubject`), it never becomes movable: Use tryDequeue with a `std::shared_ptr<const T>` instead.
+     
+     Returns `true` iff a value was moved into `value`. Does not lock. Releases the small heap object that held the value, which may free memory. Once you use tryTake, call tryTake and tryDequeue from only one thread at a time.
+     */
+    template<typename U = T>
+    typename std::enable_if<!std::is_copy_constructible<U>::value, bool>::type tryTake(T& value)
+    {
+        return detail::LockFreeTargetBase<T>::take(value);
     }
 
     /**
@@ -0,0 +1,25 @@
+#pragma once
+
+/**
+ The memory pool that ReaX uses for emitted values that are too large to be stored inline (for example large structs, or values that aren't equality-comparable).
+
+ Each thread keeps a cache of free memory blocks, so emitting values doesn't go through the global allocator, and threads that emit at the same time don't contend for it. The pool grows on demand, and never gives memory back to the system.
+
+ Call prewarm() when your plugin is loaded, so the pool doesn't have to allocate memory later.
+ */
+class MemoryPool
+{
+public:
+    /**
+     Allocates `numBlocks` free memory blocks for each block size (up to 1024 bytes).
+
+     Thread caches take blocks from these, so emitting values doesn't allocate memory until they are used up.
+     */
+    static void prewarm(size_t numBlocks = 256)
+    {
+        detail::ObjectPool::reserve(numBlocks);
+    }
+
+private:
+    MemoryPool() = delete;
+};
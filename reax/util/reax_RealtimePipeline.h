@@ -0,0 +1,360 @@
+#pragma once
+
+namespace detail {
+// A stage of a RealtimePipeline. Stages are created when the pipeline is built, and only called from RealtimePipeline::process afterwards.
+class RealtimeNode
+{
+public:
+    virtual ~RealtimeNode() {}
+
+    // Called after all values of a block have been passed through the pipeline
+    virtual void endBlock() {}
+};
+
+// Receives values of type T
+template<typename T>
+class RealtimeInput : public RealtimeNode
+{
+public:
+    virtual void onNext(const T& value) = 0;
+};
+
+// Emits values of type T to the stages that have been added after it
+template<typename T>
+class RealtimeOutput
+{
+public:
+    void addDownstream(RealtimeInput<T>* node)
+    {
+        downstream.push_back(node);
+    }
+
+protected:
+    void emit(const T& value)
+    {
+        for (auto node : downstream)
+            node->onNext(value);
+    }
+
+private:
+    std::vector<RealtimeInput<T>*> downstream;
+};
+
+// Owns the stages of a RealtimePipeline. They are stored in the order in which they were added, so each stage comes after its upstream stage.
+class RealtimeGraph
+{
+public:
+    template<typename Node>
+    Node* add(Node* node)
+    {
+        // The pipeline must be complete before it's processed
+        jassert(hasStarted.get() == 0);
+
+        nodes.emplace_back(node);
+        return node;
+    }
+
+    void endBlock()
+    {
+        hasStarted = 1;
+
+        for (auto& node : nodes)
+            node->endBlock();
+    }
+
+private:
+    std::vector<std::unique_ptr<RealtimeNode>> nodes;
+    juce::Atomic<int> hasStarted;
+};
+
+template<typename T>
+class RealtimeSourceNode : public RealtimeNode, public RealtimeOutput<T>
+{
+public:
+    void onNext(const T& value)
+    {
+        this->emit(value);
+    }
+};
+
+template<typename In, typename Out, typename Function>
+class RealtimeMapNode : public RealtimeInput<In>, public RealtimeOutput<Out>
+{
+public:
+    explicit RealtimeMapNode(const Function& function)
+    : function(function)
+    {}
+
+    void onNext(const In& value) override
+    {
+        this->emit(function(value));
+    }
+
+private:
+    Function function;
+};
+
+template<typename T, typename Predicate>
+class RealtimeFilterNode : public RealtimeInput<T>, public RealtimeOutput<T>
+{
+public:
+    explicit RealtimeFilterNode(const Predicate& predicate)
+    : predicate(predicate)
+    {}
+
+    void onNext(const T& value) override
+    {
+        if (predicate(value))
+            this->emit(value);
+    }
+
+private:
+    Predicate predicate;
+};
+
+template<typename T, typename Function>
+class RealtimeScanNode : public RealtimeInput<T>, public RealtimeOutput<T>
+{
+public:
+    RealtimeScanNode(const T& startValue, const Function& function)
+    : accumulator(startValue),
+      function(function)
+    {}
+
+    void onNext(const T& value) override
+    {
+        accumulator = function(accumulator, value);
+        this->emit(accumulator);
+    }
+
+private:
+    T accumulator;
+    Function function;
+};
+
+template<typename T, typename Equals>
+class RealtimeDistinctNode : public RealtimeInput<T>, public RealtimeOutput<T>
+{
+public:
+    explicit RealtimeDistinctNode(const Equals& equals)
+    : equals(equals)
+    {}
+
+    void onNext(const T& value) override
+    {
+        if (hasValue && equals(lastValue, value))
+            return;
+
+        lastValue = value;
+        hasValue = true;
+        this->emit(value);
+    }
+
+private:
+    Equals equals;
+    T lastValue = T();
+    bool hasValue = false;
+};
+
+// Keeps the last value of a block, and emits it when the block ends
+template<typename T>
+class RealtimeSampleNode : public RealtimeInput<T>, public RealtimeOutput<T>
+{
+public:
+    void onNext(const T& value) override
+    {
+        lastValue = value;
+        hasValue = true;
+    }
+
+    void endBlock() override
+    {
+        if (!hasValue)
+            return;
+
+        hasValue = false;
+        this->emit(lastValue);
+    }
+
+private:
+    T lastValue = T();
+    bool hasValue = false;
+};
+
+template<typename T, typename Function>
+class RealtimeSinkNode : public RealtimeInput<T>
+{
+public:
+    explicit RealtimeSinkNode(const Function& function)
+    : function(function)
+    {}
+
+    void onNext(const T& value) override
+    {
+        function(value);
+    }
+
+private:
+    Function function;
+};
+}
+
+/**
+ A stage of a RealtimePipeline, which emits values of type T. Add more stages to it with its operators, and end it with sink().
+
+ A RealtimeStage refers to its RealtimePipeline, so it must not be used after the pipeline has been destroyed.
+ */
+template<typename T>
+class RealtimeStage
+{
+public:
+    /// The type of values emitted by this stage.
+    typedef T ValueType;
+
+    /// \cond internal
+    template<typename Function, typename... Args>
+    using CallResult = typename std::decay<typename std::result_of<Function(Args...)>::type>::type;
+
+    RealtimeStage(detail::RealtimeGraph* graph, detail::RealtimeOutput<T>* output)
+    : graph(graph),
+      output(output)
+    {}
+    /// \endcond
+
+    /**
+     For each value, calls the function with that value and emits the result.
+     */
+    template<typename Function>
+    RealtimeStage<CallResult<Function, const T&>> map(Function&& function) const
+    {
+        typedef CallResult<Function, const T&> U;
+        return add<U>(new detail::RealtimeMapNode<T, U, typename std::decay<Function>::type>(std::forward<Function>(function)));
+    }
+
+    /**
+     Emits only the values that pass the predicate.
+     */
+    template<typename Predicate>
+    RealtimeStage<T> filter(Predicate&& predicate) const
+    {
+        return add<T>(new detail::RealtimeFilterNode<T, typename std::decay<Predicate>::type>(std::forward<Predicate>(predicate)));
+    }
+
+    /**
+     Emits the accumulated result of calling the function with the accumulator and each value. The first parameter to the function is the accumulator, the second is the current value.
+
+     The accumulator is kept across blocks, so this can be used for smoothing, like a one-pole filter.
+     */
+    template<typename Function>
+    RealtimeStage<T> scan(const T& startValue, Function&& function) const
+    {
+        return add<T>(new detail::RealtimeScanNode<T, typename std::decay<Function>::type>(startValue, std::forward<Function>(function)));
+    }
+
+    /**
+     Suppresses consecutive duplicate values, also across blocks. T must be default-constructible.
+     */
+    template<typename Equals = std::equal_to<T>>
+    RealtimeStage<T> distinctUntilChanged(const Equals& equals = Equals()) const
+    {
+        return add<T>(new detail::RealtimeDistinctNode<T, Equals>(equals));
+    }
+
+    /**
+     Emits only the last value of each block, when the block ends. Emits nothing for blocks without values. T must be default-constructible.
+
+     Use this to turn a per-sample signal into one control value per block.
+     */
+    RealtimeStage<T> samplePerBlock() const
+    {
+        return add<T>(new detail::RealtimeSampleNode<T>());
+    }
+
+    /**
+     Calls the function with each value. The function is called on the thread that calls RealtimePipeline::process, so it must not lock or allocate memory either.
+     */
+    template<typename Function>
+    void sink(Function&& function) const
+    {
+        link(new detail::RealtimeSinkNode<T, typename std::decay<Function>::type>(std::forward<Function>(function)));
+    }
+
+private:
+    detail::RealtimeGraph* graph;
+    detail::RealtimeOutput<T>* output;
+
+    // Adds the node after this stage, and returns it as a stage
+    template<typename U, typename Node>
+    RealtimeStage<U> add(Node* node) const
+    {
+        link(node);
+        return RealtimeStage<U>(graph, node);
+    }
+
+    template<typename Node>
+    void link(Node* node) const
+    {
+        output->addDownstream(graph->add(node));
+    }
+};
+
+/**
+ A chain of operators that runs on the audio thread, block by block, without locking or allocating memory.
+
+ Unlike an Observable, it's built once (for example when your plugin is created), and all of its stages are allocated then. Afterwards, call process() in `processBlock` to pass the values of each block through it. It supports a restricted set of operators: `map`, `filter`, `scan`, `distinctUntilChanged`, `samplePerBlock` and `sink`. Values are passed from stage to stage as `const T&`, and the functions are called directly.
+
+     RealtimePipeline<float> cutoff;
+     cutoff.input()
+         .map([](float value) { return 20.f * std::pow(1000.f, value); })
+         .scan(1000.f, [](float smoothed, float target) { return smoothed + 0.1f * (target - smoothed); })
+         .distinctUntilChanged()
+         .samplePerBlock()
+         .sink([this](float frequency) { filter.setCutoff(frequency); });
+
+     // In processBlock:
+     cutoff.process(cutoffParameter->get());
+
+ Stages may branch: Calling operators on the same RealtimeStage more than once passes each value to all of the resulting stages.
+
+ The pipeline must be complete before process() is called for the first time. The functions you pass to the operators (and the copy constructors of the values) must not lock or allocate memory, because they run on the audio thread.
+ */
+template<typename T>
+class RealtimePipeline
+{
+public:
+    /// Creates a pipeline without any stages.
+    RealtimePipeline()
+    : source(graph.add(new detail::RealtimeSourceNode<T>()))
+    {}
+
+    /// Returns the first stage, which emits the values that are passed to process().
+    RealtimeStage<T> input()
+    {
+        return RealtimeStage<T>(&graph, source);
+    }
+
+    /**
+     Passes a block of values through the pipeline. When all values have been processed, the block ends, and samplePerBlock stages emit their values.
+
+     Doesn't lock or allocate memory. Must not be called on more than one thread at the same time.
+     */
+    void process(const T* values, size_t numValues)
+    {
+        for (size_t i = 0; i < numValues; i++)
+            source->onNext(values[i]);
+
+        graph.endBlock();
+    }
+
+    /// Passes a block that consists of a single value through the pipeline, like a parameter value that is read once per block.
+    void process(const T& value)
+    {
+        process(&value, 1);
+    }
+
+private:
+    detail::RealtimeGraph graph;
+    detail::RealtimeSourceNode<T>* const source;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RealtimePipeline)
+};